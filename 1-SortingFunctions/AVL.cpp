@@ -1,32 +1,110 @@
 #include <iostream>
+#include <fstream>
 #include <algorithm>
 #include <queue>
+#include <future>
+#include <thread>
 #include "AVL.h"
+#include "MappedAVL.h"
+
+// Inserts 'num' starting from a cached spine instead of the root. Walks back up the spine to the deepest node 'num' is past,
+//	so a key near the end of the tree is found in O(log d) for distance d from the end, and one past the end in O(1).
+//	Rebalancing then stops at the first subtree that kept its height, amortized O(1) for keys arriving in order
+// PRE: 'spine' is this tree's right spine when 'right' is true, left spine otherwise, and 'other' is the opposite one
+// POST: returns false and changes nothing if the spine is not cached or 'num' is on the other side of the root. Otherwise 'num' is
+//	inserted and 'spine' follows the new shape of the tree, or is dropped if a rotation moved it in a way it cannot follow
+bool AVL::fingerInsert(int num, std::vector<Node*>& spine, std::vector<Node*>& other, bool right)
+{
+	if (spine.empty()) { return false; }
+
+	int k = static_cast<int>(spine.size()) - 1;
+	while (k >= 0 && ((right) ? num < spine[k]->data : num > spine[k]->data)) { k--; }
+	if (k < 0) { return false; } // would have to go through the root the other way, no shortcut
+	if (num == spine[k]->data) { spine[k]->count++; return true; } // duplicate, shape of the tree does not change
+
+	Node** path[MAX_HEIGHT]; // links from the root down to the new leaf, spine nodes can be written to without Unshare()
+	int depth = 0;
+	for (int i = 0; i <= k; i++) { path[depth++] = (i == 0) ? &root : (right) ? &spine[i - 1]->right : &spine[i - 1]->left; }
+
+	Node** link = (right) ? &spine[k]->right : &spine[k]->left; // 'num' sits somewhere below, past spine[k]
+	while (*link != nullptr) {
+		Node* curr = Unshare(*link);
+		if (num == curr->data) { curr->count++; return true; }
+		path[depth++] = link;
+		link = (num < curr->data) ? &curr->left : &curr->right;
+	}
+	*link = new Node{ num, 1, nullptr, nullptr, 0 };
+	if (k == static_cast<int>(spine.size()) - 1) { spine.push_back(*link); } // past the end, the leaf extends the spine
+
+	int rotated = rebalance(path, depth);
+	if (rotated >= 0 && rotated <= k + 1) { // rotation at a spine node, path[0] .. path[k + 1] all link to one
+		if (rotated + 1 < static_cast<int>(spine.size()) && *path[rotated] == spine[rotated + 1]) {
+			spine.erase(spine.begin() + rotated); // rotated outwards along the spine, the node just drops off it
+		}
+		else { spine.clear(); }
+		if (rotated == 0) { other.clear(); } // new root, the other spine starts somewhere else
+	}
+	return true;
+}
 
-// Creates a new node with the given 'num' value and inserts at bottom of tree as leaf node, calls Update() to fix heights and rotate nodes
-// PRE: 'num' is not a duplicate
-// POST: AVL tree property maintained after insertion, and root node returned
-AVL::Node* AVL::insert(int& num, Node*& curr) 
+// Walks back up an insertion path updating heights, and stops at the first subtree that kept its height since nothing above it
+//	changes either. An insertion needs at most one single or double rotation, which brings the subtree back to its old height
+// PRE: path[0] .. path[depth - 1] are the links from the root down to the parent of a new leaf, all unshared
+// POST: AVL tree property maintained, returns the index in 'path' of the rotated link, -1 if there was no rotation
+int AVL::rebalance(Node** path[], int depth)
 {
-	if (curr == nullptr) { curr = new Node{ num, nullptr, nullptr, 0 }; } // got to the end, insert as a leaf
-	else if (num <= curr->data) { insert(num, curr->left); } // num is less than curr->data, insert in left subtree
-	else if (num > curr->data) { insert(num, curr->right); } // num is greater than curr->data, insert in right subtree
+	while (depth > 0) {
+		Node*& curr = *path[--depth];
+		Node* before = curr;
+		int oldHeight = curr->height;
+
+		Update(curr); // update heights, and rotate nodes if needed
+		if (curr != before) { return depth; }
+		if (curr->height == oldHeight) { return -1; }
+	}
+	return -1;
+}
 
-	Update(curr); // update heights, and rotate nodes if needed
-	return curr;
+// Caches the path from the root to the largest key ('right' is true) or the smallest key, unsharing it so fingerInsert() can write to it
+// PRE: n/a
+// POST: 'spine' holds root, root->right, ... down to the last node on that side, empty if the tree is empty
+void AVL::cacheSpine(std::vector<Node*>& spine, bool right)
+{
+	spine.clear();
+	for (Node** link = &root; *link != nullptr; ) {
+		Node* curr = Unshare(*link);
+		spine.push_back(curr);
+		link = (right) ? &curr->right : &curr->left;
+	}
+}
+
+// Drops both insert fingers, called by anything that changes the tree other than insert() or hands its nodes to another tree
+// PRE: n/a
+// POST: next insert() starts from the root
+void AVL::resetFingers() const
+{
+	rightSpine.clear();
+	leftSpine.clear();
 }
 
-// Goes through the AVL tree to remove the node with data value 'num', updates nodes and rotates them if needed
+// Goes through the AVL tree to remove one copy of 'num'. The node itself is only removed once its count reaches 0, then nodes are
+//	updated and rotated if needed
 // PRE: n/a
 // POST: AVL tree property maintained after deletion, and root node returned
 AVL::Node* AVL::remove(int num, Node*& curr) 
 {
+	Unshare(curr); // this node's child or count is about to change
+
 	if (curr == nullptr) { return curr; }
 	else if (num < curr->data) { remove(num, curr->left); }
 	else if (num > curr->data) { remove(num, curr->right); }
+	else if (curr->count > 1) { curr->count--; return curr; } // other copies left, shape of the tree does not change
 	else if (curr->left && curr->right) { // node to remove has 2 children
-		curr->data = findMax(curr->left)->data; // find the largest value of the left subtree and set current value equal to it
-		remove(curr->data, curr->left); // find that same value in left subtree and remove it, it will be a leaf node this time
+		Node* maxNode = nullptr;
+		curr->left = splitLast(curr->left, maxNode); // detach the largest node of the left subtree and set current value and count equal to it
+		curr->data = maxNode->data;
+		curr->count = maxNode->count;
+		delete maxNode; // its left child was already handed back to the subtree
 	}
 	else { // node to remove only has 1 or 0 children
 		Node* del = curr; // keep track of the node to delete
@@ -38,7 +116,7 @@ AVL::Node* AVL::remove(int num, Node*& curr)
 	return curr;
 }
 
-// Rotates nodes if there are balance factor imbalances, then updates the heights
+// Rotates nodes if there are balance factor imbalances, then updates the heights. A shared node is only copied if it actually changes
 // PRE: n/a
 // POST: maintains the AVL tree property
 void AVL::Update(Node*& curr) 
@@ -53,7 +131,8 @@ void AVL::Update(Node*& curr)
 		else { doubleRightLeftRotate(curr); } // if right left subtree height is greater then a double rotation (right left) needs to be done
 	}
 
-	curr->height = std::max(height(curr->left), height(curr->right)) + 1; // update height after completing needed rotations
+	int newHeight = std::max(height(curr->left), height(curr->right)) + 1; // update height after completing needed rotations
+	if (curr->height != newHeight) { Unshare(curr)->height = newHeight; }
 }
 
 // Does a single right rotation of parent with its left child
@@ -61,7 +140,8 @@ void AVL::Update(Node*& curr)
 // POST: Pointers are moved correctly and nothing is leaked or lost. New head node returned
 AVL::Node* AVL::singleRightRotate(Node*& parent) // rotate parent with left child
 {
-	Node* leftChild = parent->left;
+	Unshare(parent); // both nodes get new children
+	Node* leftChild = Unshare(parent->left);
 	parent->left = leftChild->right;
 	leftChild->right = parent; // becomes the new parent
 
@@ -77,7 +157,8 @@ AVL::Node* AVL::singleRightRotate(Node*& parent) // rotate parent with left chil
 // POST: Pointers are moved correctly and nothing is leaked or lost. New head node returned
 AVL::Node* AVL::singleLeftRotate(Node*& parent) // rotate parent with left child
 {
-	Node* rightChild = parent->right;
+	Unshare(parent); // both nodes get new children
+	Node* rightChild = Unshare(parent->right);
 	parent->right = rightChild->left;
 	rightChild->left = parent; // becomes the new parent
 
@@ -132,25 +213,242 @@ int AVL::getBalance(Node* curr) const
 	return (curr == nullptr) ? 0 : height(curr->left) - height(curr->right); 
 }
 
-// Finds the node with the maximum value in the tree by going as right as possible iteratively
-// PRE: Assumes that the tree is properly ordered as a BST
-// POST: Returns the node ptr of the node with the maximum value
-AVL::Node* AVL::findMax(Node* curr) const
+// Recursively builds a perfectly balanced subtree out of keys[s] .. keys[e], middle key becomes the subtree root
+// PRE: keys[s] .. keys[e] are sorted in ascending order with no duplicates, counts[i] is the number of copies of keys[i]
+// POST: returns the root of a balanced subtree holding e - s + 1 nodes, built in O(n) with no rotations
+AVL::Node* AVL::build(const std::vector<int>& keys, const std::vector<int>& counts, int s, int e)
 {
-	if (curr == nullptr) { return nullptr; }
-	while (curr->right != nullptr) { curr = curr->right; }
+	if (s > e) { return nullptr; }
+
+	int mid = s + (e - s) / 2;
+	Node* curr = new Node{ keys[mid], counts[mid], nullptr, nullptr, 0 };
+	curr->left = build(keys, counts, s, mid - 1);
+	curr->right = build(keys, counts, mid + 1, e);
+	curr->height = std::max(height(curr->left), height(curr->right)) + 1;
 	return curr;
 }
 
+// Joins subtrees 'l' and 'r' with 'mid' as the node between them. Walks down the spine of the taller subtree until the heights are
+//	within 1 of the shorter one, hangs 'mid' there, and lets Update() rotate on the way back up
+// PRE: every key in 'l' < mid->data < every key in 'r', 'mid' is a detached node
+// POST: returns the root of a balanced tree holding all three, runs in O(|height(l) - height(r)| + 1)
+AVL::Node* AVL::join(Node* l, Node* mid, Node* r)
+{
+	if (height(l) > height(r) + 1) { // left is taller, follow its right spine
+		Unshare(l);
+		l->right = join(l->right, mid, r);
+		Update(l);
+		return l;
+	}
+	if (height(r) > height(l) + 1) { // right is taller, follow its left spine
+		Unshare(r);
+		r->left = join(l, mid, r->left);
+		Update(r);
+		return r;
+	}
+
+	mid->left = l;
+	mid->right = r;
+	mid->height = std::max(height(l), height(r)) + 1;
+	return mid;
+}
+
+// Joins subtrees 'l' and 'r' when there is no middle node, by pulling the largest node out of 'l' to use as one
+// PRE: every key in 'l' < every key in 'r'
+// POST: returns the root of a balanced tree holding both
+AVL::Node* AVL::join2(Node* l, Node* r)
+{
+	if (l == nullptr) { return r; }
+
+	Node* last = nullptr;
+	l = splitLast(l, last);
+	return join(l, last, r);
+}
+
+// Splits the subtree at 'curr' around 'key' into 'l' (keys less than 'key') and 'r' (keys greater than 'key')
+// PRE: n/a
+// POST: 'curr' is consumed. Returns the detached node holding 'key', or nullptr if it was not in the subtree
+AVL::Node* AVL::split(Node* curr, int key, Node*& l, Node*& r)
+{
+	if (curr == nullptr) { l = r = nullptr; return nullptr; }
+	Unshare(curr); // 'curr' gets relinked, its subtrees can stay shared
+
+	Node* left = curr->left;
+	Node* right = curr->right;
+	Node* found = nullptr;
+
+	if (key == curr->data) {
+		l = left;
+		r = right;
+		curr->left = curr->right = nullptr;
+		curr->height = 0;
+		return curr;
+	}
+	else if (key < curr->data) { // 'key' splits the left subtree, 'curr' and its right subtree go on the greater side
+		found = split(left, key, l, r);
+		r = join(r, curr, right);
+	}
+	else { // 'key' splits the right subtree, 'curr' and its left subtree go on the lesser side
+		found = split(right, key, l, r);
+		l = join(left, curr, l);
+	}
+	return found;
+}
+
+// Removes the node with the largest key from the subtree at 'curr' and hands it back through 'last'
+// PRE: 'curr' is not a nullptr
+// POST: returns the new, rebalanced root of the subtree, 'last' is detached from it
+AVL::Node* AVL::splitLast(Node* curr, Node*& last)
+{
+	Unshare(curr);
+	if (curr->right == nullptr) { last = curr; return curr->left; }
+
+	curr->right = splitLast(curr->right, last);
+	Update(curr);
+	return curr;
+}
+
+// Join based union, splits 'b' around the root of 'a' and unites the two halves independently. The halves share no nodes, so
+//	while 'threads' > 1 and the subtree is tall enough one half is handed to another thread
+// PRE: n/a
+// POST: both subtrees are consumed, returns the root of the union. Keys found in both keep the node from 'a' with the counts added
+AVL::Node* AVL::unite(Node* a, Node* b, int threads)
+{
+	if (a == nullptr) { return b; }
+	if (b == nullptr) { return a; }
+	Unshare(a);
+
+	Node* l2 = nullptr;
+	Node* r2 = nullptr;
+	Node* dup = split(b, a->data, l2, r2);
+	if (dup) { // already in 'a', add its copies and drop the node
+		a->count += dup->count;
+		delete dup;
+	}
+
+	Node* left = a->left;
+	Node* right = a->right;
+	if (threads > 1 && height(a) >= PAR_CUTOFF_HEIGHT) {
+		std::future<Node*> leftDone = std::async(std::launch::async, [&] { return unite(left, l2, threads / 2); });
+		right = unite(right, r2, threads - threads / 2);
+		left = leftDone.get();
+	}
+	else {
+		left = unite(left, l2, 1);
+		right = unite(right, r2, 1);
+	}
+	return join(left, a, right);
+}
+
+// Join based intersection, same divide and conquer as unite(). The root of 'a' is kept only if 'b' also held its key
+// PRE: n/a
+// POST: both subtrees are consumed, nodes not in the intersection are deallocated, returns the root of the intersection.
+//	Each kept key has the smaller of its two counts
+AVL::Node* AVL::intersect(Node* a, Node* b, int threads)
+{
+	if (a == nullptr || b == nullptr) {
+		Deallocate(a);
+		Deallocate(b);
+		return nullptr;
+	}
+	Unshare(a);
+
+	Node* l2 = nullptr;
+	Node* r2 = nullptr;
+	Node* found = split(b, a->data, l2, r2);
+
+	Node* left = a->left;
+	Node* right = a->right;
+	if (threads > 1 && height(a) >= PAR_CUTOFF_HEIGHT) {
+		std::future<Node*> leftDone = std::async(std::launch::async, [&] { return intersect(left, l2, threads / 2); });
+		right = intersect(right, r2, threads - threads / 2);
+		left = leftDone.get();
+	}
+	else {
+		left = intersect(left, l2, 1);
+		right = intersect(right, r2, 1);
+	}
+
+	if (found) {
+		a->count = std::min(a->count, found->count);
+		delete found;
+		return join(left, a, right);
+	}
+	delete a;
+	return join2(left, right);
+}
+
+// Join based difference (a - b), splits 'a' around the root of 'b' and takes the copies in 'b' off the node holding that key
+// PRE: n/a
+// POST: both subtrees are consumed, nodes left with no copies are deallocated, returns the root of the difference
+AVL::Node* AVL::difference(Node* a, Node* b, int threads)
+{
+	if (a == nullptr || b == nullptr) {
+		Deallocate(b);
+		return a;
+	}
+	Unshare(b);
+
+	Node* l1 = nullptr;
+	Node* r1 = nullptr;
+	Node* found = split(a, b->data, l1, r1);
+	if (found && found->count <= b->count) { delete found; found = nullptr; }
+	else if (found) { found->count -= b->count; }
+
+	bool parallel = threads > 1 && height(b) >= PAR_CUTOFF_HEIGHT;
+	Node* left = b->left;
+	Node* right = b->right;
+	delete b;
+	if (parallel) {
+		std::future<Node*> leftDone = std::async(std::launch::async, [&] { return difference(l1, left, threads / 2); });
+		right = difference(r1, right, threads - threads / 2);
+		left = leftDone.get();
+	}
+	else {
+		left = difference(l1, left, 1);
+		right = difference(r1, right, 1);
+	}
+	return (found) ? join(left, found, right) : join2(left, right);
+}
+
 // Default constructor
 AVL::AVL() : root{ nullptr } 
 {
 }
 
-// Copy constructor, calls DeepCopy() function to deep copy each element in 'copyit' AVL
-AVL::AVL(const AVL& copyit) : root{ nullptr }
+// Bulk constructor, builds a perfectly balanced tree straight from 'keys' in O(n) instead of n separate insert() calls.
+//	Runs of equal keys collapse into one node. Unsorted input is copied and sorted first, O(n log n)
+// PRE: 'isSorted' is only true when 'keys' is already in ascending order
+// POST: tree holds every key in 'keys' and satisfies the AVL tree property
+AVL::AVL(const std::vector<int>& keys, bool isSorted) : root{ nullptr }
+{
+	std::vector<int> sorted;
+	if (!isSorted) {
+		sorted = keys;
+		std::sort(sorted.begin(), sorted.end());
+	}
+	const std::vector<int>& in = (isSorted) ? keys : sorted;
+
+	std::vector<int> distinct;
+	std::vector<int> counts;
+	for (int key : in) {
+		if (!distinct.empty() && distinct.back() == key) { counts.back()++; }
+		else {
+			distinct.push_back(key);
+			counts.push_back(1);
+		}
+	}
+	root = build(distinct, counts, 0, static_cast<int>(distinct.size()) - 1);
+}
+
+// Copy constructor, shares every node of 'copyit' instead of copying them. Runs in O(1), nodes are only copied once either tree
+//	writes to them
+// PRE: no other thread is modifying 'copyit'
+// POST: tree holds the same keys as 'copyit', later updates to either tree are not seen by the other
+AVL::AVL(const AVL& copyit) : root{ copyit.root }
 {
-	DeepCopy(copyit);
+	if (root) { root->refs++; }
+	copyit.resetFingers(); // its spine nodes are shared now
 }
 
 // Default destructor, calls recursive destructor() function
@@ -159,74 +457,214 @@ AVL::~AVL()
 	Deallocate(root);
 }
 
-// Assignment operator which checks for self reference, deallocates old nodes, and deep copies new nodes in correct positions
-// PRE: that the AVL tree passed in is not itself, which is checked for
-// POST: the dynamic memory of old nodes deallocated, and 'copyit' elements deep copied into the same positions in new tree
+// Assignment operator, releases the old nodes and shares the nodes of 'copyit' like the copy constructor
+// PRE: no other thread is modifying 'copyit'
+// POST: old nodes no other tree points to are deallocated, tree holds the same keys as 'copyit'
 AVL& AVL::operator=(const AVL& copyit)
 {
-	// return if trying to assign itself. we do not want '*this' AVL to deallocate itself and then fail to deep copy
-	if (this == &copyit) { return *this; }
+	resetFingers();
+	copyit.resetFingers();
+	Node* old = root;
+	root = copyit.root;
+	if (root) { root->refs++; } // take the new reference first, so self assignment does not free the tree
+	Deallocate(old);
 
-	Deallocate(root);
-	DeepCopy(copyit);
+	return *this;
+}
 
+// Returns a frozen copy of the tree in O(1). Writers can keep updating this tree while other threads read the snapshot,
+//	each update copies only the O(log n) nodes on its path that are still shared
+// PRE: called by the thread that updates this tree, or under the same lock
+// POST: returned tree holds the current keys and is never affected by later updates
+AVL AVL::snapshot() const
+{
 	return *this;
 }
 
-// Recursive deallocate function, calls itself on its children until it reaches leaves, deletes them, then goes up the stack to delete
+// Recursive deallocate function, drops one reference to 'curr'. Once nothing points to a node it is deleted and the same is done
+//	to its children, subtrees still shared with another tree are left alone
 // PRE: tree not large enough to cause stack overflow
-// POST: all dynamic memory cleared and not leaked
+// POST: all dynamic memory no longer reachable from any tree cleared and not leaked
 void AVL::Deallocate(Node*& curr)
 {
 	if (curr == nullptr) { return; }
-	Deallocate(curr->left);
-	Deallocate(curr->right);
-	delete curr;
+	if (curr->refs.fetch_sub(1) == 1) { // last reference
+		Deallocate(curr->left);
+		Deallocate(curr->right);
+		delete curr;
+	}
 	curr = nullptr;
 }
 
-// Iteratively deep copies elements from 'copyit' to '*this' AVL using a queue and level order traversal to maintain same order of nodes
-// PRE: 'copyit' is not empty, otherwise return
-// POST: copied values must be in same position on the new tree
-void AVL::DeepCopy(const AVL& copyit)
+// Copy on write, clones 'curr' if any other tree or snapshot also points to it. The clone takes a new reference on both children,
+//	so only this one node is copied and its subtrees stay shared until they are written to as well
+// PRE: every ancestor of 'curr' in this tree is already unshared
+// POST: 'curr' is only reachable from this tree and safe to modify, returns it
+AVL::Node* AVL::Unshare(Node*& curr)
 {
-	if (copyit.root == nullptr) { return; }
+	if (curr == nullptr || curr->refs.load() == 1) { return curr; }
 
-	std::queue<Node*> lvlTravQ;
-	lvlTravQ.push(copyit.root);
-
-	while (!lvlTravQ.empty()) {
-		Node* tmp = lvlTravQ.front();
-		if (tmp->left) { lvlTravQ.push(tmp->left); }
-		if (tmp->right) { lvlTravQ.push(tmp->right); }
-
-		insert(tmp->data);
-		lvlTravQ.pop(); // pop front node
-	}
+	Node* copy = new Node{ curr->data, curr->count, curr->left, curr->right, curr->height };
+	if (copy->left) { copy->left->refs++; }
+	if (copy->right) { copy->right->refs++; }
+	Deallocate(curr); // drops this tree's reference to the original, frees it if the other owners let go in the meantime
+	curr = copy;
+	return curr;
 }
 
-// Calls helper function
-// PRE: num is not a duplicate
-// POST: num is inserted into AVL tree, tree is balanced, and heights updated
+// Iteratively inserts 'num', trying the right and left fingers first so keys arriving in order (or reverse order) skip the search
+//	from the root. Otherwise walks down from the root keeping the path, a duplicate only bumps the count of the node holding 'num'.
+//	Nodes shared with a snapshot are copied on the way down, and rebalancing stops as soon as a subtree keeps its height.
+//	An insert that lands past either end caches that spine for the inserts after it
+// PRE: n/a
+// POST: num is inserted into AVL tree (or its count bumped if already there), tree is balanced, and heights updated
 void AVL::insert(int num) 
 { 
-	insert(num, root); 
+	if (fingerInsert(num, rightSpine, leftSpine, true) || fingerInsert(num, leftSpine, rightSpine, false)) { return; }
+
+	Node** path[MAX_HEIGHT];
+	int depth = 0;
+	bool allRight = true;
+	bool allLeft = true;
+	Node** link = &root;
+	while (*link != nullptr) {
+		Node* curr = Unshare(*link); // this node's child or count is about to change
+		if (num == curr->data) { curr->count++; return; } // duplicate, shape of the tree does not change
+		path[depth++] = link;
+		if (num < curr->data) { link = &curr->left; allRight = false; } // num is less than curr->data, insert in left subtree
+		else { link = &curr->right; allLeft = false; } // num is greater than curr->data, insert in right subtree
+	}
+	*link = new Node{ num, 1, nullptr, nullptr, 0 }; // got to the end, insert as a leaf
+
+	rebalance(path, depth);
+	resetFingers(); // a rotation anywhere on the path may have moved a spine
+	if (allRight) { cacheSpine(rightSpine, true); }
+	if (allLeft) { cacheSpine(leftSpine, false); }
+}
+
+// Inserts every key of 'keys' as one batch. A batch that falls entirely past either end of the tree is built in O(m) and joined on
+//	in O(log n), anything else is built and merged in with the join based union
+// PRE: 'keys' is sorted in ascending order
+// POST: tree holds every key in 'keys' as well and is balanced
+void AVL::insertSorted(const std::vector<int>& keys)
+{
+	if (keys.empty()) { return; }
+
+	AVL batch(keys, true);
+	resetFingers();
+
+	Node* lo = root;
+	Node* hi = root;
+	while (lo && lo->left) { lo = lo->left; }
+	while (hi && hi->right) { hi = hi->right; }
+
+	if (root == nullptr || keys.front() > hi->data) { root = join2(root, batch.root); }
+	else if (keys.back() < lo->data) { root = join2(batch.root, root); }
+	else { root = unite(root, batch.root, std::max(1u, std::thread::hardware_concurrency())); }
+	batch.root = nullptr;
 }
 
 // Calls helper function
 // PRE: n/a
-// POST: num is removed if it exists, tree is balanced, heights updated
+// POST: one copy of num is removed if it exists, tree is balanced, heights updated
 void AVL::remove(int num) 
 { 
+	resetFingers();
 	remove(num, root); 
 }
 
-// Recursive function to get the number of nodes in the tree/subtree
+// Iteratively searches for 'num' from the root
+// PRE: n/a
+// POST: returns true if num is in the tree
+bool AVL::contains(int num) const
+{
+	Node* curr = root;
+	while (curr != nullptr && curr->data != num) { curr = (num < curr->data) ? curr->left : curr->right; }
+	return curr != nullptr;
+}
+
+// Joins 'key' and every node of 'right' onto the end of this tree, leaving 'right' empty
+// PRE: every key in this tree < key < every key in 'right'
+// POST: tree is balanced, runs in O(log n)
+void AVL::join(int key, AVL& right)
+{
+	if (this == &right) { return; }
+
+	resetFingers();
+	right.resetFingers();
+	root = join(root, new Node{ key, 1, nullptr, nullptr, 0 }, right.root);
+	right.root = nullptr;
+}
+
+// Moves the keys less than 'key' into 'left' and the keys greater than 'key' into 'right', leaving this tree empty.
+//	Old contents of 'left' and 'right' are deallocated, and so is every copy of 'key'
+// PRE: 'left' and 'right' are different trees
+// POST: both halves are balanced, returns true if 'key' was in the tree. Runs in O(log n)
+bool AVL::split(int key, AVL& left, AVL& right)
+{
+	resetFingers();
+	left.resetFingers();
+	right.resetFingers();
+	Node* whole = root;
+	root = nullptr;
+	Deallocate(left.root);
+	Deallocate(right.root);
+
+	Node* found = split(whole, key, left.root, right.root);
+	delete found;
+	return found != nullptr;
+}
+
+// Moves every key of 'other' into this tree with the join based union, leaving 'other' empty.
+//	Runs in O(m log(n/m + 1)) work for trees of size m <= n, with the two halves of each split run in parallel
+// PRE: n/a
+// POST: tree holds the multiset union of both trees (counts added) and is balanced. A tree united with itself has every count doubled
+void AVL::unionWith(AVL& other)
+{
+	if (this == &other) { // unite() needs two owners, a snapshot shares the nodes until they are written to
+		AVL copy(*this);
+		unionWith(copy);
+		return;
+	}
+
+	resetFingers();
+	other.resetFingers();
+	root = unite(root, other.root, std::max(1u, std::thread::hardware_concurrency()));
+	other.root = nullptr;
+}
+
+// Keeps only the keys that are also in 'other', leaving 'other' empty. Same bounds as unionWith()
+// PRE: n/a
+// POST: tree holds the multiset intersection of both trees (smaller count kept) and is balanced
+void AVL::intersectWith(AVL& other)
+{
+	if (this == &other) { return; }
+
+	resetFingers();
+	other.resetFingers();
+	root = intersect(root, other.root, std::max(1u, std::thread::hardware_concurrency()));
+	other.root = nullptr;
+}
+
+// Removes as many copies of each key as 'other' holds, leaving 'other' empty. Same bounds as unionWith()
+// PRE: n/a
+// POST: tree holds the multiset difference of both trees and is balanced
+void AVL::differenceWith(AVL& other)
+{
+	if (this == &other) { resetFingers(); Deallocate(root); return; }
+
+	resetFingers();
+	other.resetFingers();
+	root = difference(root, other.root, std::max(1u, std::thread::hardware_concurrency()));
+	other.root = nullptr;
+}
+
+// Recursive function to get the number of keys in the tree/subtree, counting every copy of a duplicate
 // PRE: tree not large enough to cause stack overflow
-// POST: Number of nodes is returned
+// POST: Number of keys is returned
 int AVL::size(Node* curr) const
 {
-	return (!curr) ? 0 : 1 + size(curr->left) + size(curr->right);
+	return (!curr) ? 0 : curr->count + size(curr->left) + size(curr->right);
 }
 
 // Calls helper function
@@ -244,7 +682,7 @@ void AVL::inOrder(Node* curr) const
 {
 	if (curr == nullptr) { return; }
 	inOrder(curr->left);
-	std::cout << curr->data << '\n';
+	for (int i = 0; i < curr->count; i++) { std::cout << curr->data << '\n'; }
 	inOrder(curr->right);
 }
 
@@ -255,4 +693,43 @@ void AVL::inOrder() const
 {
 	inOrder(root);
 	std::cout << '\n';
-}
\ No newline at end of file
+}
+
+// Writes the tree to 'path' in the flat, pointer free layout MappedAVL reads. Nodes are numbered in level order using a queue, and
+//	each child is stored as its offset from the parent: after popping node i the queue holds nodes i + 1 .. i + q, so the next child
+//	pushed will be node i + q + 1
+// PRE: n/a
+// POST: returns true if the whole file was written, the tree is not modified
+bool AVL::save(const std::string& path) const
+{
+	std::vector<AVLFileNode> out;
+	uint64_t keys = 0;
+
+	std::queue<Node*> lvlTravQ;
+	if (root) { lvlTravQ.push(root); }
+	while (!lvlTravQ.empty()) {
+		Node* tmp = lvlTravQ.front();
+		lvlTravQ.pop();
+
+		int32_t next = static_cast<int32_t>(lvlTravQ.size()) + 1;
+		AVLFileNode node{ tmp->data, tmp->count, 0, 0 };
+		if (tmp->left) { node.left = next++; lvlTravQ.push(tmp->left); }
+		if (tmp->right) { node.right = next; lvlTravQ.push(tmp->right); }
+
+		out.push_back(node);
+		keys += tmp->count;
+	}
+
+	AVLFileHeader header;
+	std::copy(AVL_FILE_MAGIC, AVL_FILE_MAGIC + sizeof(AVL_FILE_MAGIC), header.magic);
+	header.version = AVL_FILE_VERSION;
+	header.nodes = static_cast<uint32_t>(out.size());
+	header.levels = static_cast<uint32_t>(height(root) + 1);
+	header.keys = keys;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(out.data()), out.size() * sizeof(AVLFileNode));
+	file.close();
+	return !file.fail();
+}
@@ -1,19 +1,36 @@
 #pragma once
 
+#include <vector>
+#include <atomic>
+#include <string>
+
 class AVL {
 private:
 	struct Node {
 		int data;
+		int count; // copies of 'data', duplicates share one node
 		Node* left;
 		Node* right;
 		int height;
+		std::atomic<int> refs{ 1 }; // trees and parent nodes pointing here, a node with refs > 1 is shared and never modified
 	};
 	Node* root;
 
+	// Insert fingers, the cached path from the root down to the largest / smallest key. Empty when not cached.
+	//	mutable because copying a tree shares its nodes, so the copy constructor has to drop the source's fingers
+	mutable std::vector<Node*> rightSpine;
+	mutable std::vector<Node*> leftSpine;
+
+	static const int PAR_CUTOFF_HEIGHT = 10; // subtrees shorter than this are never split across threads
+	static const int MAX_HEIGHT = 64; // taller than any AVL tree that fits in memory, bounds an insertion path
+
 	void Deallocate(Node*& curr);
-	void DeepCopy(const AVL& copyit);
+	Node* Unshare(Node*& curr);
 
-	Node* insert(int& num, Node*& curr);
+	bool fingerInsert(int num, std::vector<Node*>& spine, std::vector<Node*>& other, bool right);
+	int rebalance(Node** path[], int depth);
+	void cacheSpine(std::vector<Node*>& spine, bool right);
+	void resetFingers() const;
 	Node* remove(int num, Node*& curr);
 
 	void Update(Node*& curr);
@@ -25,18 +42,38 @@ private:
 	int size(Node* curr) const;
 	int height(Node* curr) const;
 	int getBalance(Node* curr) const;
-	Node* findMax(Node* curr) const;
 	void inOrder(Node* curr) const;
 
+	Node* build(const std::vector<int>& keys, const std::vector<int>& counts, int s, int e);
+	Node* join(Node* l, Node* mid, Node* r);
+	Node* join2(Node* l, Node* r);
+	Node* split(Node* curr, int key, Node*& l, Node*& r);
+	Node* splitLast(Node* curr, Node*& last);
+	Node* unite(Node* a, Node* b, int threads);
+	Node* intersect(Node* a, Node* b, int threads);
+	Node* difference(Node* a, Node* b, int threads);
+
 public:
 	AVL();
+	explicit AVL(const std::vector<int>& keys, bool isSorted = false);
 	~AVL();
 	AVL(const AVL&);
 	AVL& operator=(const AVL&);
+	AVL snapshot() const;
 
 	void insert(int num);
+	void insertSorted(const std::vector<int>& keys);
 	void remove(int num);
+	bool contains(int num) const;
+
+	void join(int key, AVL& right);
+	bool split(int key, AVL& left, AVL& right);
+	void unionWith(AVL& other);
+	void intersectWith(AVL& other);
+	void differenceWith(AVL& other);
 
 	int size() const;
 	void inOrder() const;
+
+	bool save(const std::string& path) const;
 };
\ No newline at end of file
@@ -0,0 +1,391 @@
+#include <iostream>
+#include <algorithm>
+#include "BPlusTree.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BPT_USE_SSE2
+#endif
+
+#ifdef BPT_USE_SSE2
+static const int MASK_BITS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 }; // popcount of a 4 bit movemask
+#endif
+
+// Counts the keys in keys[0] .. keys[n-1] that are less than 'key', 4 at a time with SSE2 and branch free. Since the keys in a
+//	node are sorted this is also the index of the first key >= 'key'
+// PRE: keys[0] .. keys[n-1] are sorted in ascending order
+// POST: returns the lower bound position of 'key'
+int BPlusTree::countLess(const int* keys, int n, int key)
+{
+	int i = 0;
+	int cnt = 0;
+#ifdef BPT_USE_SSE2
+	__m128i k = _mm_set1_epi32(key);
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+		cnt += MASK_BITS[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, k)))];
+	}
+#endif
+	for (; i < n; i++) { cnt += keys[i] < key; }
+	return cnt;
+}
+
+// Counts the keys in keys[0] .. keys[n-1] that are less than or equal to 'key', same as countLess()
+// PRE: keys[0] .. keys[n-1] are sorted in ascending order
+// POST: returns the upper bound position of 'key'
+int BPlusTree::countLessEqual(const int* keys, int n, int key)
+{
+	int i = 0;
+	int cnt = 0;
+#ifdef BPT_USE_SSE2
+	__m128i k = _mm_set1_epi32(key);
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+		cnt += 4 - MASK_BITS[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, k)))];
+	}
+#endif
+	for (; i < n; i++) { cnt += keys[i] <= key; }
+	return cnt;
+}
+
+// Inserts 'key' into the subtree at 'curr', after any keys equal to it. A full node is split in half on the way back up
+// PRE: 'curr' is not a nullptr
+// POST: returns true if 'curr' was split, in which case 'sibling' is the new right half and 'upKey' the separator for the parent
+bool BPlusTree::insert(Node* curr, int key, int& upKey, Node*& sibling)
+{
+	if (curr->leaf) {
+		Leaf* leaf = static_cast<Leaf*>(curr);
+		int pos = countLessEqual(leaf->keys, leaf->n, key);
+		if (leaf->n < LEAF_KEYS) {
+			std::copy_backward(leaf->keys + pos, leaf->keys + leaf->n, leaf->keys + leaf->n + 1);
+			leaf->keys[pos] = key;
+			leaf->n++;
+			return false;
+		}
+
+		// full, move the upper half into a new leaf then insert into whichever half 'key' belongs to
+		const int half = LEAF_KEYS / 2;
+		Leaf* right = new Leaf();
+		right->leaf = true;
+		right->n = LEAF_KEYS - half;
+		std::copy(leaf->keys + half, leaf->keys + LEAF_KEYS, right->keys);
+		right->next = leaf->next;
+		leaf->n = half;
+		leaf->next = right;
+
+		Leaf* target = (pos <= half) ? leaf : right;
+		if (target == right) { pos -= half; }
+		std::copy_backward(target->keys + pos, target->keys + target->n, target->keys + target->n + 1);
+		target->keys[pos] = key;
+		target->n++;
+
+		upKey = right->keys[0];
+		sibling = right;
+		return true;
+	}
+
+	Inner* node = static_cast<Inner*>(curr);
+	int i = countLessEqual(node->keys, node->n, key);
+	int childUp;
+	Node* childSibling;
+	if (!insert(node->children[i], key, childUp, childSibling)) { return false; }
+
+	if (node->n < INNER_KEYS) { // room for the new separator
+		std::copy_backward(node->keys + i, node->keys + node->n, node->keys + node->n + 1);
+		std::copy_backward(node->children + i + 1, node->children + node->n + 1, node->children + node->n + 2);
+		node->keys[i] = childUp;
+		node->children[i + 1] = childSibling;
+		node->n++;
+		return false;
+	}
+
+	// full, lay out all INNER_KEYS + 1 separators in order, keep the lower half, push the middle one up and move the rest right
+	int tmpKeys[INNER_KEYS + 1];
+	Node* tmpChildren[INNER_KEYS + 2];
+	std::copy(node->keys, node->keys + i, tmpKeys);
+	tmpKeys[i] = childUp;
+	std::copy(node->keys + i, node->keys + INNER_KEYS, tmpKeys + i + 1);
+	std::copy(node->children, node->children + i + 1, tmpChildren);
+	tmpChildren[i + 1] = childSibling;
+	std::copy(node->children + i + 1, node->children + INNER_KEYS + 1, tmpChildren + i + 2);
+
+	const int mid = (INNER_KEYS + 1) / 2;
+	Inner* right = new Inner();
+	right->leaf = false;
+	right->n = INNER_KEYS - mid;
+	std::copy(tmpKeys + mid + 1, tmpKeys + INNER_KEYS + 1, right->keys);
+	std::copy(tmpChildren + mid + 1, tmpChildren + INNER_KEYS + 2, right->children);
+
+	node->n = mid;
+	std::copy(tmpKeys, tmpKeys + mid, node->keys);
+	std::copy(tmpChildren, tmpChildren + mid + 1, node->children);
+
+	upKey = tmpKeys[mid];
+	sibling = right;
+	return true;
+}
+
+// Removes one copy of 'key' from the subtree at 'curr'. Equal keys can straddle a separator, so when the separator equals 'key'
+//	the child to its right is tried as well
+// PRE: 'curr' is not a nullptr
+// POST: returns true if a key was removed, underfull children are fixed by fixChild() on the way back up
+bool BPlusTree::remove(Node* curr, int key)
+{
+	if (curr->leaf) {
+		Leaf* leaf = static_cast<Leaf*>(curr);
+		int pos = countLess(leaf->keys, leaf->n, key);
+		if (pos == leaf->n || leaf->keys[pos] != key) { return false; }
+
+		std::copy(leaf->keys + pos + 1, leaf->keys + leaf->n, leaf->keys + pos);
+		leaf->n--;
+		return true;
+	}
+
+	Inner* node = static_cast<Inner*>(curr);
+	int i = countLess(node->keys, node->n, key);
+	while (true) {
+		if (remove(node->children[i], key)) {
+			fixChild(node, i);
+			return true;
+		}
+		if (i < node->n && node->keys[i] == key) { i++; }
+		else { return false; }
+	}
+}
+
+// Refills children[i] of 'parent' if it fell below half full, by borrowing a key from a sibling that can spare one,
+//	or otherwise by merging it with a sibling and dropping the separator between them from 'parent'
+// PRE: 0 <= i <= parent->n, every other child of 'parent' is at least half full
+// POST: children[i] (or the node it was merged into) is at least half full, 'parent' may be left underfull for its own parent to fix
+void BPlusTree::fixChild(Inner* parent, int i)
+{
+	Node* child = parent->children[i];
+	int mergeAt = -1; // separator to drop from 'parent' after a merge
+
+	if (child->leaf) {
+		if (child->n >= LEAF_MIN) { return; }
+
+		Leaf* c = static_cast<Leaf*>(child);
+		Leaf* left = (i > 0) ? static_cast<Leaf*>(parent->children[i - 1]) : nullptr;
+		Leaf* right = (i < parent->n) ? static_cast<Leaf*>(parent->children[i + 1]) : nullptr;
+
+		if (left && left->n > LEAF_MIN) { // take the largest key of the left sibling
+			std::copy_backward(c->keys, c->keys + c->n, c->keys + c->n + 1);
+			c->keys[0] = left->keys[--left->n];
+			c->n++;
+			parent->keys[i - 1] = c->keys[0];
+		}
+		else if (right && right->n > LEAF_MIN) { // take the smallest key of the right sibling
+			c->keys[c->n++] = right->keys[0];
+			std::copy(right->keys + 1, right->keys + right->n, right->keys);
+			right->n--;
+			parent->keys[i] = right->keys[0];
+		}
+		else {
+			if (left) { right = c; c = left; mergeAt = i - 1; } // merge child into its left sibling
+			else { mergeAt = i; }                               // merge right sibling into child
+			std::copy(right->keys, right->keys + right->n, c->keys + c->n);
+			c->n += right->n;
+			c->next = right->next;
+			delete right;
+		}
+	}
+	else {
+		if (child->n >= INNER_MIN) { return; }
+
+		Inner* c = static_cast<Inner*>(child);
+		Inner* left = (i > 0) ? static_cast<Inner*>(parent->children[i - 1]) : nullptr;
+		Inner* right = (i < parent->n) ? static_cast<Inner*>(parent->children[i + 1]) : nullptr;
+
+		if (left && left->n > INNER_MIN) { // rotate the left sibling's last child through the parent separator
+			std::copy_backward(c->keys, c->keys + c->n, c->keys + c->n + 1);
+			std::copy_backward(c->children, c->children + c->n + 1, c->children + c->n + 2);
+			c->keys[0] = parent->keys[i - 1];
+			c->children[0] = left->children[left->n];
+			c->n++;
+			parent->keys[i - 1] = left->keys[--left->n];
+		}
+		else if (right && right->n > INNER_MIN) { // rotate the right sibling's first child through the parent separator
+			c->keys[c->n] = parent->keys[i];
+			c->children[c->n + 1] = right->children[0];
+			c->n++;
+			parent->keys[i] = right->keys[0];
+			std::copy(right->keys + 1, right->keys + right->n, right->keys);
+			std::copy(right->children + 1, right->children + right->n + 1, right->children);
+			right->n--;
+		}
+		else {
+			if (left) { right = c; c = left; mergeAt = i - 1; }
+			else { mergeAt = i; }
+			c->keys[c->n] = parent->keys[mergeAt]; // separator comes down between the two halves
+			std::copy(right->keys, right->keys + right->n, c->keys + c->n + 1);
+			std::copy(right->children, right->children + right->n + 1, c->children + c->n + 1);
+			c->n += right->n + 1;
+			delete right;
+		}
+	}
+
+	if (mergeAt >= 0) { // drop separator keys[mergeAt] and the merged away child to its right
+		std::copy(parent->keys + mergeAt + 1, parent->keys + parent->n, parent->keys + mergeAt);
+		std::copy(parent->children + mergeAt + 2, parent->children + parent->n + 1, parent->children + mergeAt + 1);
+		parent->n--;
+	}
+}
+
+// Recursively deletes every node in the subtree
+// PRE: tree not deep enough to cause stack overflow (it is at most ~6 levels for 2^31 keys)
+// POST: all dynamic memory cleared and not leaked
+void BPlusTree::Deallocate(Node* curr)
+{
+	if (curr == nullptr) { return; }
+	if (curr->leaf) { delete static_cast<Leaf*>(curr); return; }
+
+	Inner* node = static_cast<Inner*>(curr);
+	for (int i = 0; i <= node->n; i++) { Deallocate(node->children[i]); }
+	delete node;
+}
+
+// Recursively copies the subtree at 'curr', relinking the copied leaves left to right through 'prevLeaf'
+// PRE: 'prevLeaf' is the last leaf copied so far, nullptr before the first
+// POST: returns the root of the copy, nodes are in the same positions as in the original
+BPlusTree::Node* BPlusTree::DeepCopy(const Node* curr, Leaf*& prevLeaf)
+{
+	if (curr == nullptr) { return nullptr; }
+
+	if (curr->leaf) {
+		Leaf* copy = new Leaf(*static_cast<const Leaf*>(curr));
+		copy->next = nullptr;
+		if (prevLeaf) { prevLeaf->next = copy; }
+		prevLeaf = copy;
+		return copy;
+	}
+
+	Inner* copy = new Inner(*static_cast<const Inner*>(curr));
+	for (int i = 0; i <= copy->n; i++) { copy->children[i] = DeepCopy(copy->children[i], prevLeaf); }
+	return copy;
+}
+
+// Goes as far left as possible to find the first leaf
+// PRE: n/a
+// POST: returns the leftmost leaf, nullptr if the tree is empty
+BPlusTree::Leaf* BPlusTree::firstLeaf() const
+{
+	Node* curr = root;
+	if (curr == nullptr) { return nullptr; }
+	while (!curr->leaf) { curr = static_cast<Inner*>(curr)->children[0]; }
+	return static_cast<Leaf*>(curr);
+}
+
+// Default constructor
+BPlusTree::BPlusTree() : root{ nullptr }, count{ 0 }
+{
+}
+
+// Default destructor
+BPlusTree::~BPlusTree()
+{
+	Deallocate(root);
+}
+
+// Copy constructor, deep copies every node of 'copyit'
+BPlusTree::BPlusTree(const BPlusTree& copyit) : root{ nullptr }, count{ copyit.count }
+{
+	Leaf* prevLeaf = nullptr;
+	root = DeepCopy(copyit.root, prevLeaf);
+}
+
+// Assignment operator which checks for self reference, deallocates old nodes, and deep copies the nodes of 'copyit'
+// PRE: that the tree passed in is not itself, which is checked for
+// POST: old nodes deallocated, 'copyit' nodes deep copied into the same positions
+BPlusTree& BPlusTree::operator=(const BPlusTree& copyit)
+{
+	if (this == &copyit) { return *this; }
+
+	Deallocate(root);
+	Leaf* prevLeaf = nullptr;
+	root = DeepCopy(copyit.root, prevLeaf);
+	count = copyit.count;
+
+	return *this;
+}
+
+// Calls helper function, grows a new root when the old one splits
+// PRE: n/a
+// POST: num is inserted, every node other than the root is at least half full
+void BPlusTree::insert(int num)
+{
+	if (root == nullptr) {
+		Leaf* leaf = new Leaf();
+		leaf->leaf = true;
+		root = leaf;
+	}
+
+	int upKey;
+	Node* sibling;
+	if (insert(root, num, upKey, sibling)) {
+		Inner* newRoot = new Inner();
+		newRoot->leaf = false;
+		newRoot->n = 1;
+		newRoot->keys[0] = upKey;
+		newRoot->children[0] = root;
+		newRoot->children[1] = sibling;
+		root = newRoot;
+	}
+	count++;
+}
+
+// Calls helper function, drops the root when it is left with a single child or no keys
+// PRE: n/a
+// POST: one copy of num is removed if it exists, every node other than the root is at least half full
+void BPlusTree::remove(int num)
+{
+	if (root == nullptr || !remove(root, num)) { return; }
+	count--;
+
+	if (!root->leaf && root->n == 0) {
+		Inner* old = static_cast<Inner*>(root);
+		root = old->children[0];
+		delete old;
+	}
+	else if (root->leaf && root->n == 0) {
+		delete static_cast<Leaf*>(root);
+		root = nullptr;
+	}
+}
+
+// Descends to the leftmost leaf that could hold 'num', equal keys may start at the front of the next leaf
+// PRE: n/a
+// POST: returns true if num is in the tree
+bool BPlusTree::contains(int num) const
+{
+	Node* curr = root;
+	if (curr == nullptr) { return false; }
+	while (!curr->leaf) {
+		Inner* node = static_cast<Inner*>(curr);
+		curr = node->children[countLess(node->keys, node->n, num)];
+	}
+
+	Leaf* leaf = static_cast<Leaf*>(curr);
+	int pos = countLess(leaf->keys, leaf->n, num);
+	if (pos < leaf->n) { return leaf->keys[pos] == num; }
+	return leaf->next != nullptr && leaf->next->keys[0] == num;
+}
+
+// Number of keys is tracked on insert/remove
+// PRE: n/a
+// POST: returns the number of keys in the tree
+int BPlusTree::size() const
+{
+	return count;
+}
+
+// Walks the leaf chain left to right and prints every key, reading each leaf sequentially
+// PRE: n/a
+// POST: prints the keys in ascending order
+void BPlusTree::inOrder() const
+{
+	for (Leaf* leaf = firstLeaf(); leaf != nullptr; leaf = leaf->next) {
+		for (int i = 0; i < leaf->n; i++) { std::cout << leaf->keys[i] << '\n'; }
+	}
+	std::cout << '\n';
+}
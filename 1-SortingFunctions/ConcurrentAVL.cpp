@@ -0,0 +1,671 @@
+#include <iostream>
+#include <algorithm>
+#include "ConcurrentAVL.h"
+
+// Node conditions returned by nodeCondition(), any value >= 0 is instead the height the node should have
+static const int UNLINK_REQUIRED = -1;
+static const int REBALANCE_REQUIRED = -2;
+static const int NOTHING_REQUIRED = -3;
+
+// Epoch based reclamation, shared by every tree. Each thread that has used a tree owns one record announcing the epoch its
+//	current operation started in, or QUIESCENT between operations. The list of records only grows, a thread hands its record
+//	back when it exits so the list is as long as the most threads ever alive at once
+static const unsigned long long QUIESCENT = ~0ULL;
+static const size_t RECLAIM_BATCH = 1024; // retired nodes a tree collects before it tries to free them
+
+struct alignas(64) EpochRecord {
+	std::atomic<unsigned long long> epoch{ QUIESCENT };
+	std::atomic<bool> inUse{ true };
+	EpochRecord* next = nullptr;
+	int depth = 0; // guards open on the owning thread, only that thread touches it
+};
+
+static std::atomic<unsigned long long> globalEpoch{ 1 };
+static std::atomic<EpochRecord*> epochRecords{ nullptr };
+
+struct EpochOwner {
+	EpochRecord* record = nullptr;
+	~EpochOwner() { if (record) { record->inUse = false; } }
+};
+static thread_local EpochOwner epochOwner;
+
+// Returns this thread's record, taking one another thread gave back or adding a new one the first time it is called
+// PRE: n/a
+// POST: the record belongs to this thread until it exits
+static EpochRecord* MyEpochRecord()
+{
+	if (epochOwner.record) { return epochOwner.record; }
+
+	for (EpochRecord* r = epochRecords; r != nullptr; r = r->next) {
+		bool expected = false;
+		if (!r->inUse && r->inUse.compare_exchange_strong(expected, true)) { return epochOwner.record = r; }
+	}
+	EpochRecord* r = new EpochRecord;
+	r->next = epochRecords;
+	while (!epochRecords.compare_exchange_weak(r->next, r)) {}
+	return epochOwner.record = r;
+}
+
+// Announces the global epoch for the length of one public operation. Both the announcement and the loads of the tree after it
+//	are sequentially consistent, so a reclaim() that misses the announcement also happened before the reader could reach any
+//	node it frees
+class EpochGuard {
+private:
+	EpochRecord* record;
+
+public:
+	EpochGuard() : record{ MyEpochRecord() } { if (record->depth++ == 0) { record->epoch = globalEpoch.load(); } }
+	~EpochGuard() { if (--record->depth == 0) { record->epoch = QUIESCENT; } }
+	EpochGuard(const EpochGuard&) = delete;
+	EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Returns the height of the node passed in, 0 if nullptr
+// PRE: n/a
+// POST: returns the last height written to the node, may be stale while other threads are rebalancing
+int ConcurrentAVL::height(Node* curr)
+{
+	return (curr == nullptr) ? 0 : curr->height.load();
+}
+
+// Looks at a node without locking it to decide what repair it needs
+// PRE: n/a
+// POST: returns UNLINK_REQUIRED for routing nodes with < 2 children, REBALANCE_REQUIRED if the balance factor is off by more
+//	than 1, the corrected height if only the height is wrong, and NOTHING_REQUIRED otherwise
+int ConcurrentAVL::nodeCondition(Node* node)
+{
+	Node* nL = node->left;
+	Node* nR = node->right;
+	if ((nL == nullptr || nR == nullptr) && !node->present) { return UNLINK_REQUIRED; }
+
+	int hN = node->height;
+	int hL0 = height(nL);
+	int hR0 = height(nR);
+	int hNRepl = 1 + std::max(hL0, hR0);
+	int bal = hL0 - hR0;
+
+	if (bal < -1 || bal > 1) { return REBALANCE_REQUIRED; }
+	return (hN != hNRepl) ? hNRepl : NOTHING_REQUIRED;
+}
+
+// Spins while 'node' is being rotated, then blocks on its lock since the rotating thread holds it
+// PRE: n/a
+// POST: the rotation that was in progress when called has finished
+void ConcurrentAVL::waitUntilNotChanging(Node* node)
+{
+	long long v = node->version;
+	if ((v & SHRINKING) == 0) { return; }
+
+	for (int i = 0; i < 100; i++) {
+		if (node->version != v) { return; }
+	}
+	std::lock_guard<std::mutex> wait(node->lock);
+}
+
+// Hand-over-hand optimistic search for 'num' below node->child(dir). Each child is only trusted after checking that 'node'
+//	has not been rotated since 'nodeV' was read, so no locks are taken
+// PRE: 'nodeV' is the version of 'node' read before its child pointer
+// POST: returns FOUND/NOT_FOUND, or RETRY if 'node' changed and the caller has to revalidate its own link
+ConcurrentAVL::Result ConcurrentAVL::attemptContains(int num, Node* node, int dir, long long nodeV) const
+{
+	while (true) {
+		Node* child = node->child(dir);
+		if (child == nullptr) {
+			if (node->version != nodeV) { return RETRY; }
+			return NOT_FOUND;
+		}
+
+		if (num == child->data) { return child->present ? FOUND : NOT_FOUND; }
+		int childDir = (num < child->data) ? -1 : 1;
+
+		long long childV = child->version;
+		if (childV & SHRINKING) { waitUntilNotChanging(child); }
+		else if ((childV & UNLINKED) == 0 && child == node->child(dir)) {
+			if (node->version != nodeV) { return RETRY; }
+			Result r = attemptContains(num, child, childDir, childV);
+			if (r != RETRY) { return r; }
+		}
+		// the child changed underneath us, reread it from 'node' unless 'node' itself moved
+		if (node->version != nodeV) { return RETRY; }
+	}
+}
+
+// Same descent as attemptContains(), links a new leaf where the search falls off the tree or marks a routing node present
+// PRE: 'nodeV' is the version of 'node' read before its child pointer
+// POST: returns NOT_FOUND if 'num' was added, FOUND if it was already present, RETRY if 'node' changed
+ConcurrentAVL::Result ConcurrentAVL::attemptInsert(int num, Node* node, int dir, long long nodeV)
+{
+	Result r = RETRY;
+	do {
+		Node* child = node->child(dir);
+		if (node->version != nodeV) { return RETRY; }
+
+		if (child == nullptr) { r = attemptLinkLeaf(num, node, dir, nodeV); }
+		else if (num == child->data) { r = attemptMarkPresent(child); }
+		else {
+			int childDir = (num < child->data) ? -1 : 1;
+			long long childV = child->version;
+			if (childV & SHRINKING) { waitUntilNotChanging(child); }
+			else if ((childV & UNLINKED) == 0 && child == node->child(dir)) {
+				if (node->version != nodeV) { return RETRY; }
+				r = attemptInsert(num, child, childDir, childV);
+			}
+		}
+	} while (r == RETRY);
+	return r;
+}
+
+// Locks 'node' and hangs a new leaf off of it, if nothing changed since the search read it
+// PRE: node->child(dir) was a nullptr when 'nodeV' was read
+// POST: returns NOT_FOUND after linking the leaf and rebalancing, RETRY if 'node' changed or gained that child
+ConcurrentAVL::Result ConcurrentAVL::attemptLinkLeaf(int num, Node* node, int dir, long long nodeV)
+{
+	{
+		std::lock_guard<std::mutex> guard(node->lock);
+		if (node->version != nodeV || node->child(dir) != nullptr) { return RETRY; }
+		node->child(dir) = new Node(num, true, 1, node);
+	}
+	fixHeightAndRebalance(node);
+	return NOT_FOUND;
+}
+
+// Locks 'node' and marks its key present, turning a routing node back into a regular one
+// PRE: node->data is the key being inserted
+// POST: returns FOUND if the key was already present, NOT_FOUND if it was added, RETRY if 'node' was unlinked meanwhile
+ConcurrentAVL::Result ConcurrentAVL::attemptMarkPresent(Node* node)
+{
+	std::lock_guard<std::mutex> guard(node->lock);
+	if (node->version & UNLINKED) { return RETRY; }
+
+	bool prev = node->present;
+	node->present = true;
+	return prev ? FOUND : NOT_FOUND;
+}
+
+// Same descent as attemptContains(), removes 'num' through attemptRemoveNode() once its node is reached
+// PRE: 'nodeV' is the version of 'node' read before its child pointer
+// POST: returns FOUND if 'num' was removed, NOT_FOUND if it was not present, RETRY if 'node' changed
+ConcurrentAVL::Result ConcurrentAVL::attemptRemove(int num, Node* node, int dir, long long nodeV)
+{
+	Result r = RETRY;
+	do {
+		Node* child = node->child(dir);
+		if (node->version != nodeV) { return RETRY; }
+		if (child == nullptr) { return NOT_FOUND; }
+
+		if (num == child->data) { r = attemptRemoveNode(node, child); }
+		else {
+			int childDir = (num < child->data) ? -1 : 1;
+			long long childV = child->version;
+			if (childV & SHRINKING) { waitUntilNotChanging(child); }
+			else if ((childV & UNLINKED) == 0 && child == node->child(dir)) {
+				if (node->version != nodeV) { return RETRY; }
+				r = attemptRemove(num, child, childDir, childV);
+			}
+		}
+	} while (r == RETRY);
+	return r;
+}
+
+// A node with two children only becomes a routing node, which needs just its own lock. A node with at most one child is
+//	spliced out of the tree, which needs the parent locked as well
+// PRE: 'parent' was the parent of 'node' when the search passed it
+// POST: returns FOUND if the key was removed, NOT_FOUND if it was not present, RETRY if the shape changed meanwhile
+ConcurrentAVL::Result ConcurrentAVL::attemptRemoveNode(Node* parent, Node* node)
+{
+	if (!node->present) { return NOT_FOUND; }
+
+	bool prev;
+	if (node->left != nullptr && node->right != nullptr) {
+		std::lock_guard<std::mutex> guard(node->lock);
+		if ((node->version & UNLINKED) || node->left == nullptr || node->right == nullptr) { return RETRY; }
+		prev = node->present;
+		node->present = false;
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> parentGuard(parent->lock);
+			if ((parent->version & UNLINKED) || node->parent != parent) { return RETRY; }
+
+			std::lock_guard<std::mutex> guard(node->lock);
+			if (node->version & UNLINKED) { return RETRY; }
+			prev = node->present;
+			node->present = false;
+			if (node->left == nullptr || node->right == nullptr) { attemptUnlink_nl(parent, node); }
+		}
+		fixHeightAndRebalance(parent);
+	}
+	return prev ? FOUND : NOT_FOUND;
+}
+
+// Walks up from 'node' to the root fixing heights, unlinking routing nodes and rotating, one node at a time. Only locks the
+//	node (and its parent when its shape has to change), so it can run alongside other updates. Nodes that need nothing are
+//	only read, the walk does not stop at them since a rotation below may have left a stale height further up
+// PRE: n/a
+// POST: every node on the path to the root satisfies the AVL tree property, unless another thread is still repairing it
+void ConcurrentAVL::fixHeightAndRebalance(Node* node)
+{
+	while (node != nullptr && node->parent != nullptr) {
+		if (node->version & UNLINKED) { return; } // whoever unlinked it repairs from its parent
+
+		int condition = nodeCondition(node);
+		if (condition == NOTHING_REQUIRED) { node = node->parent; continue; }
+
+		if (condition != UNLINK_REQUIRED && condition != REBALANCE_REQUIRED) {
+			std::lock_guard<std::mutex> guard(node->lock);
+			node = fixHeight_nl(node);
+		}
+		else {
+			Node* nP = node->parent;
+			std::lock_guard<std::mutex> parentGuard(nP->lock);
+			if ((nP->version & UNLINKED) == 0 && node->parent == nP) {
+				std::lock_guard<std::mutex> guard(node->lock);
+				node = rebalance_nl(nP, node);
+			}
+			// else the parent changed, loop around and look at 'node' again
+		}
+	}
+}
+
+// Corrects the height of a locked node
+// PRE: 'node' is locked
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::fixHeight_nl(Node* node)
+{
+	int condition = nodeCondition(node);
+	switch (condition) {
+	case REBALANCE_REQUIRED:
+	case UNLINK_REQUIRED:
+		return node;
+	case NOTHING_REQUIRED:
+		return node->parent;
+	default:
+		node->height = condition;
+		return node->parent;
+	}
+}
+
+// Unlinks, rotates or fixes the height of a locked node
+// PRE: 'parent' and 'node' are locked, 'parent' is the parent of 'node'
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rebalance_nl(Node* parent, Node* node)
+{
+	Node* nL = node->left;
+	Node* nR = node->right;
+	if ((nL == nullptr || nR == nullptr) && !node->present) {
+		return attemptUnlink_nl(parent, node) ? fixHeight_nl(parent) : node;
+	}
+
+	int hN = node->height;
+	int hL0 = height(nL);
+	int hR0 = height(nR);
+	int hNRepl = 1 + std::max(hL0, hR0);
+	int bal = hL0 - hR0;
+
+	if (bal > 1) { return rebalanceToRight_nl(parent, node, nL, hR0); }
+	else if (bal < -1) { return rebalanceToLeft_nl(parent, node, nR, hL0); }
+	else if (hNRepl != hN) {
+		node->height = hNRepl;
+		return fixHeight_nl(parent);
+	}
+	return parent;
+}
+
+// Left heavy node, locks the left child (and its right child for a double rotation) and picks the rotation like AVL::Update()
+// PRE: 'parent' and 'node' are locked, 'nL' was the left child of 'node'
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rebalanceToRight_nl(Node* parent, Node* node, Node* nL, int hR0)
+{
+	std::lock_guard<std::mutex> leftGuard(nL->lock);
+	int hL = nL->height;
+	if (hL - hR0 <= 1) { return node; } // changed since we looked, retry
+
+	Node* nLR = nL->right;
+	int hLL0 = height(nL->left);
+	int hLR0 = height(nLR);
+	if (hLL0 >= hLR0) { return rotateRight_nl(parent, node, nL, hR0, hLL0, nLR, hLR0); }
+
+	{
+		std::lock_guard<std::mutex> leftRightGuard(nLR->lock);
+		int hLR = nLR->height;
+		if (hLL0 >= hLR) { return rotateRight_nl(parent, node, nL, hR0, hLL0, nLR, hLR); }
+
+		int hLRL = height(nLR->left);
+		int b = hLL0 - hLRL;
+		if (b >= -1 && b <= 1) { return rotateRightOverLeft_nl(parent, node, nL, hR0, hLL0, nLR, hLRL); }
+	}
+	// a double rotation would leave nL unbalanced, rotate nL first
+	return rebalanceToLeft_nl(node, nL, nLR, hLL0);
+}
+
+// Mirror image of rebalanceToRight_nl()
+// PRE: 'parent' and 'node' are locked, 'nR' was the right child of 'node'
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rebalanceToLeft_nl(Node* parent, Node* node, Node* nR, int hL0)
+{
+	std::lock_guard<std::mutex> rightGuard(nR->lock);
+	int hR = nR->height;
+	if (hL0 - hR >= -1) { return node; }
+
+	Node* nRL = nR->left;
+	int hRL0 = height(nRL);
+	int hRR0 = height(nR->right);
+	if (hRR0 >= hRL0) { return rotateLeft_nl(parent, node, hL0, nR, nRL, hRL0, hRR0); }
+
+	{
+		std::lock_guard<std::mutex> rightLeftGuard(nRL->lock);
+		int hRL = nRL->height;
+		if (hRR0 >= hRL) { return rotateLeft_nl(parent, node, hL0, nR, nRL, hRL, hRR0); }
+
+		int hRLR = height(nRL->right);
+		int b = hRR0 - hRLR;
+		if (b >= -1 && b <= 1) { return rotateLeftOverRight_nl(parent, node, hL0, nR, nRL, hRR0, hRLR); }
+	}
+	return rebalanceToRight_nl(node, nR, nRL, hRR0);
+}
+
+// Single right rotation of 'node' with its left child, 'node' is marked SHRINKING for the duration so readers below it wait
+// PRE: 'parent', 'node' and 'nL' are locked
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rotateRight_nl(Node* parent, Node* node, Node* nL, int hR, int hLL, Node* nLR, int hLR)
+{
+	long long nodeOVL = node->version;
+	Node* nPL = parent->left;
+
+	node->version = beginChange(nodeOVL);
+
+	node->left = nLR;
+	if (nLR != nullptr) { nLR->parent = node; }
+	nL->right = node;
+	node->parent = nL;
+	if (nPL == node) { parent->left = nL; }
+	else { parent->right = nL; }
+	nL->parent = parent;
+
+	int hNRepl = 1 + std::max(hLR, hR);
+	node->height = hNRepl;
+	nL->height = 1 + std::max(hLL, hNRepl);
+
+	node->version = endChange(nodeOVL);
+
+	int balN = hLR - hR;
+	if (balN < -1 || balN > 1) { return node; }
+	if ((nLR == nullptr || hR == 0) && !node->present) { return node; }
+	int balL = hLL - hNRepl;
+	if (balL < -1 || balL > 1) { return nL; }
+	if (hLL == 0 && !nL->present) { return nL; }
+	return fixHeight_nl(parent);
+}
+
+// Mirror image of rotateRight_nl()
+// PRE: 'parent', 'node' and 'nR' are locked
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rotateLeft_nl(Node* parent, Node* node, int hL, Node* nR, Node* nRL, int hRL, int hRR)
+{
+	long long nodeOVL = node->version;
+	Node* nPL = parent->left;
+
+	node->version = beginChange(nodeOVL);
+
+	node->right = nRL;
+	if (nRL != nullptr) { nRL->parent = node; }
+	nR->left = node;
+	node->parent = nR;
+	if (nPL == node) { parent->left = nR; }
+	else { parent->right = nR; }
+	nR->parent = parent;
+
+	int hNRepl = 1 + std::max(hL, hRL);
+	node->height = hNRepl;
+	nR->height = 1 + std::max(hNRepl, hRR);
+
+	node->version = endChange(nodeOVL);
+
+	int balN = hRL - hL;
+	if (balN < -1 || balN > 1) { return node; }
+	if ((nRL == nullptr || hL == 0) && !node->present) { return node; }
+	int balR = hRR - hNRepl;
+	if (balR < -1 || balR > 1) { return nR; }
+	if (hRR == 0 && !nR->present) { return nR; }
+	return fixHeight_nl(parent);
+}
+
+// Double LR rotation done in one step, both 'node' and 'nL' move down so both are marked SHRINKING
+// PRE: 'parent', 'node', 'nL' and 'nLR' are locked
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rotateRightOverLeft_nl(Node* parent, Node* node, Node* nL, int hR, int hLL, Node* nLR, int hLRL)
+{
+	long long nodeOVL = node->version;
+	long long leftOVL = nL->version;
+	Node* nPL = parent->left;
+	Node* nLRL = nLR->left;
+	Node* nLRR = nLR->right;
+	int hLRR = height(nLRR);
+
+	node->version = beginChange(nodeOVL);
+	nL->version = beginChange(leftOVL);
+
+	node->left = nLRR;
+	if (nLRR != nullptr) { nLRR->parent = node; }
+	nL->right = nLRL;
+	if (nLRL != nullptr) { nLRL->parent = nL; }
+	nLR->left = nL;
+	nL->parent = nLR;
+	nLR->right = node;
+	node->parent = nLR;
+	if (nPL == node) { parent->left = nLR; }
+	else { parent->right = nLR; }
+	nLR->parent = parent;
+
+	int hNRepl = 1 + std::max(hLRR, hR);
+	node->height = hNRepl;
+	int hLRepl = 1 + std::max(hLL, hLRL);
+	nL->height = hLRepl;
+	nLR->height = 1 + std::max(hLRepl, hNRepl);
+
+	node->version = endChange(nodeOVL);
+	nL->version = endChange(leftOVL);
+
+	int balN = hLRR - hR;
+	if (balN < -1 || balN > 1) { return node; }
+	if ((nLRR == nullptr || hR == 0) && !node->present) { return node; }
+	if ((hLL == 0 || hLRL == 0) && !nL->present) { return nL; } // nL became a routing node with a missing child, unlink it
+	int balLR = hLRepl - hNRepl;
+	if (balLR < -1 || balLR > 1) { return nLR; }
+	return fixHeight_nl(parent);
+}
+
+// Mirror image of rotateRightOverLeft_nl()
+// PRE: 'parent', 'node', 'nR' and 'nRL' are locked
+// POST: returns the next node to look at
+ConcurrentAVL::Node* ConcurrentAVL::rotateLeftOverRight_nl(Node* parent, Node* node, int hL, Node* nR, Node* nRL, int hRR, int hRLR)
+{
+	long long nodeOVL = node->version;
+	long long rightOVL = nR->version;
+	Node* nPL = parent->left;
+	Node* nRLL = nRL->left;
+	Node* nRLR = nRL->right;
+	int hRLL = height(nRLL);
+
+	node->version = beginChange(nodeOVL);
+	nR->version = beginChange(rightOVL);
+
+	node->right = nRLL;
+	if (nRLL != nullptr) { nRLL->parent = node; }
+	nR->left = nRLR;
+	if (nRLR != nullptr) { nRLR->parent = nR; }
+	nRL->right = nR;
+	nR->parent = nRL;
+	nRL->left = node;
+	node->parent = nRL;
+	if (nPL == node) { parent->left = nRL; }
+	else { parent->right = nRL; }
+	nRL->parent = parent;
+
+	int hNRepl = 1 + std::max(hL, hRLL);
+	node->height = hNRepl;
+	int hRRepl = 1 + std::max(hRLR, hRR);
+	nR->height = hRRepl;
+	nRL->height = 1 + std::max(hNRepl, hRRepl);
+
+	node->version = endChange(nodeOVL);
+	nR->version = endChange(rightOVL);
+
+	int balN = hRLL - hL;
+	if (balN < -1 || balN > 1) { return node; }
+	if ((nRLL == nullptr || hL == 0) && !node->present) { return node; }
+	if ((hRR == 0 || hRLR == 0) && !nR->present) { return nR; }
+	int balRL = hRRepl - hNRepl;
+	if (balRL < -1 || balRL > 1) { return nRL; }
+	return fixHeight_nl(parent);
+}
+
+// Splices a node with at most one child out of the tree and retires it
+// PRE: 'parent' and 'node' are locked
+// POST: returns false if 'node' is no longer a child of 'parent' or has two children
+bool ConcurrentAVL::attemptUnlink_nl(Node* parent, Node* node)
+{
+	Node* parentL = parent->left;
+	Node* parentR = parent->right;
+	if (parentL != node && parentR != node) { return false; }
+
+	Node* left = node->left;
+	Node* right = node->right;
+	if (left != nullptr && right != nullptr) { return false; }
+
+	Node* splice = (left != nullptr) ? left : right;
+	if (parentL == node) { parent->left = splice; }
+	else { parent->right = splice; }
+	if (splice != nullptr) { splice->parent = parent; }
+
+	node->version = UNLINKED;
+	node->present = false;
+	retire(node);
+	return true;
+}
+
+// Keeps an unlinked node alive while a lock free reader may still be standing on it, tagged with the epoch it was unlinked in.
+//	Every RECLAIM_BATCH retirements the ones no running operation can reach any more are freed
+// PRE: 'node' has been unlinked, called from inside an operation's EpochGuard
+// POST: 'node' is freed by a later reclaim() or by the destructor
+void ConcurrentAVL::retire(Node* node)
+{
+	std::lock_guard<std::mutex> guard(retiredLock);
+	retired.push_back({ node, globalEpoch.load() });
+	if (retired.size() >= reclaimAt) { reclaim(); }
+}
+
+// Advances the global epoch, then frees every retired node whose epoch is older than all announced ones. An operation that
+//	could still reach a node started before it was unlinked, so it announced an epoch <= the node's. Nodes kept because of a
+//	slow reader wait for the next batch instead of being rescanned on every retire()
+// PRE: 'retiredLock' is held
+// POST: 'retired' only holds nodes a running operation may still read
+void ConcurrentAVL::reclaim()
+{
+	globalEpoch++; // operations starting from here on cannot reach anything retired so far
+	unsigned long long oldest = QUIESCENT;
+	for (EpochRecord* r = epochRecords; r != nullptr; r = r->next) { oldest = std::min(oldest, r->epoch.load()); }
+
+	size_t kept = 0;
+	for (const Retired& r : retired) {
+		if (r.epoch < oldest) { delete r.node; }
+		else { retired[kept++] = r; }
+	}
+	retired.resize(kept);
+	reclaimAt = kept + RECLAIM_BATCH;
+}
+
+// Default constructor
+ConcurrentAVL::ConcurrentAVL() : rootHolder{ 0, false, 0, nullptr }, reclaimAt{ RECLAIM_BATCH }
+{
+}
+
+// Default destructor, frees the tree and every retired node still waiting for reclaim()
+// PRE: no other thread is using the tree
+// POST: all dynamic memory cleared and not leaked
+ConcurrentAVL::~ConcurrentAVL()
+{
+	Deallocate(rootHolder.right);
+	for (const Retired& r : retired) { delete r.node; }
+}
+
+// Recursive deallocate function
+// PRE: no other thread is using the tree
+// POST: all nodes in the subtree deleted
+void ConcurrentAVL::Deallocate(Node* curr)
+{
+	if (curr == nullptr) { return; }
+	Deallocate(curr->left);
+	Deallocate(curr->right);
+	delete curr;
+}
+
+// Calls helper function until it gets an answer that was not invalidated by a concurrent rotation
+// PRE: n/a
+// POST: returns true if num was added, false if it was already present
+bool ConcurrentAVL::insert(int num)
+{
+	EpochGuard epoch;
+	Result r;
+	while ((r = attemptInsert(num, &rootHolder, 1, 0)) == RETRY) {}
+	return r == NOT_FOUND;
+}
+
+// Calls helper function until it gets an answer that was not invalidated by a concurrent rotation
+// PRE: n/a
+// POST: returns true if num was removed, false if it was not present
+bool ConcurrentAVL::remove(int num)
+{
+	EpochGuard epoch;
+	Result r;
+	while ((r = attemptRemove(num, &rootHolder, 1, 0)) == RETRY) {}
+	return r == FOUND;
+}
+
+// Calls helper function until it gets an answer that was not invalidated by a concurrent rotation, never blocks on updates
+// PRE: n/a
+// POST: returns true if num is present
+bool ConcurrentAVL::contains(int num) const
+{
+	EpochGuard epoch;
+	Node* holder = const_cast<Node*>(&rootHolder);
+	Result r;
+	while ((r = attemptContains(num, holder, 1, 0)) == RETRY) {}
+	return r == FOUND;
+}
+
+// Recursive function to count the present keys in the subtree, routing nodes are skipped
+// PRE: no concurrent updates, otherwise the count is only approximate
+// POST: number of keys is returned
+int ConcurrentAVL::size(Node* curr) const
+{
+	return (!curr) ? 0 : (curr->present ? 1 : 0) + size(curr->left) + size(curr->right);
+}
+
+// Calls helper function
+// PRE: no concurrent updates, otherwise the count is only approximate
+// POST: returns the number of keys
+int ConcurrentAVL::size() const
+{
+	return size(rootHolder.right);
+}
+
+// Recursively prints the present keys in inorder
+// PRE: no concurrent updates
+// POST: prints the keys in ascending order
+void ConcurrentAVL::inOrder(Node* curr) const
+{
+	if (curr == nullptr) { return; }
+	inOrder(curr->left);
+	if (curr->present) { std::cout << curr->data << '\n'; }
+	inOrder(curr->right);
+}
+
+// Calls helper function
+// PRE: no concurrent updates
+// POST: prints the keys in ascending order
+void ConcurrentAVL::inOrder() const
+{
+	inOrder(rootHolder.right);
+	std::cout << '\n';
+}
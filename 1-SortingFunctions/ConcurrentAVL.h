@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Concurrent ordered set of ints built on AVL balancing, after Bronson, Casper, Chafi and Olukotun,
+// "A Practical Concurrent Binary Search Tree" (PPoPP 2010).
+//	- lookups take no locks: they walk down hand-over-hand, validating the version of each node after reading its child,
+//	  and retry from the last valid node if a rotation moved the subtree underneath them
+//	- insert/remove lock only the one or two nodes they link or unlink, so updates on different parts of the tree run in parallel
+//	- a removed key with two children stays in the tree as a routing node, it is unlinked once it has at most one child
+//	- balancing is relaxed: heights are repaired and rotations done bottom up after an update, locking parent, node and child
+// Unlinked nodes may still be read by a concurrent lookup, so they are retired and freed with epoch based reclamation: every
+// operation announces the global epoch it started in, and a node retired in epoch e is freed once no running operation
+// announced an epoch <= e.
+// Run ThreadSanitizer with TSAN_OPTIONS=detect_deadlocks=0. Locks are always taken parent before child, but a rotation turns a
+// child into its old parent's parent, so TSan sees the same two node locks taken in both orders and reports lock-order
+// inversions that cannot deadlock. Data race detection is unaffected.
+class ConcurrentAVL {
+private:
+	// version bits, the rest of the version counts completed rotations of the node
+	static const long long UNLINKED = 1;  // node was removed from the tree
+	static const long long SHRINKING = 2; // node is being rotated down, readers wait then revalidate
+	static const long long CHANGE_INCR = 4;
+	static long long beginChange(long long ovl) { return ovl | SHRINKING; }
+	static long long endChange(long long ovl) { return ovl + CHANGE_INCR; } // 'ovl' had SHRINKING clear, so this clears it too
+
+	struct Node {
+		const int data;
+		std::atomic<bool> present;    // false for routing nodes
+		std::atomic<int> height;      // 1 for leaves, 0 is used for nullptr
+		std::atomic<long long> version;
+		std::atomic<Node*> parent;
+		std::atomic<Node*> left;
+		std::atomic<Node*> right;
+		std::mutex lock;
+
+		Node(int num, bool isPresent, int h, Node* p)
+			: data{ num }, present{ isPresent }, height{ h }, version{ 0 }, parent{ p }, left{ nullptr }, right{ nullptr } {}
+		std::atomic<Node*>& child(int dir) { return (dir < 0) ? left : right; }
+	};
+
+	struct Retired {
+		Node* node;
+		unsigned long long epoch; // global epoch read after the node was unlinked
+	};
+
+	Node rootHolder; // sentinel, the real root is its right child
+	std::mutex retiredLock;
+	std::vector<Retired> retired;
+	size_t reclaimAt; // size of 'retired' that triggers the next reclaim()
+
+	enum Result { NOT_FOUND, FOUND, RETRY };
+
+	Result attemptContains(int num, Node* node, int dir, long long nodeV) const;
+	Result attemptInsert(int num, Node* node, int dir, long long nodeV);
+	Result attemptLinkLeaf(int num, Node* node, int dir, long long nodeV);
+	Result attemptMarkPresent(Node* node);
+	Result attemptRemove(int num, Node* node, int dir, long long nodeV);
+	Result attemptRemoveNode(Node* parent, Node* node);
+	static void waitUntilNotChanging(Node* node);
+
+	void fixHeightAndRebalance(Node* node);
+	Node* fixHeight_nl(Node* node);
+	Node* rebalance_nl(Node* parent, Node* node);
+	Node* rebalanceToRight_nl(Node* parent, Node* node, Node* nL, int hR0);
+	Node* rebalanceToLeft_nl(Node* parent, Node* node, Node* nR, int hL0);
+	Node* rotateRight_nl(Node* parent, Node* node, Node* nL, int hR, int hLL, Node* nLR, int hLR);
+	Node* rotateLeft_nl(Node* parent, Node* node, int hL, Node* nR, Node* nRL, int hRL, int hRR);
+	Node* rotateRightOverLeft_nl(Node* parent, Node* node, Node* nL, int hR, int hLL, Node* nLR, int hLRL);
+	Node* rotateLeftOverRight_nl(Node* parent, Node* node, int hL, Node* nR, Node* nRL, int hRR, int hRLR);
+	bool attemptUnlink_nl(Node* parent, Node* node);
+	void retire(Node* node);
+	void reclaim();
+
+	static int height(Node* curr);
+	static int nodeCondition(Node* node);
+
+	void Deallocate(Node* curr);
+	int size(Node* curr) const;
+	void inOrder(Node* curr) const;
+
+public:
+	ConcurrentAVL();
+	~ConcurrentAVL();
+	ConcurrentAVL(const ConcurrentAVL&) = delete;
+	ConcurrentAVL& operator=(const ConcurrentAVL&) = delete;
+
+	bool insert(int num);
+	bool remove(int num);
+	bool contains(int num) const;
+
+	int size() const;
+	void inOrder() const;
+};
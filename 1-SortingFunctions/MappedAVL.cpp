@@ -0,0 +1,152 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedAVL.h"
+
+// Default constructor, nothing is mapped until open()
+MappedAVL::MappedAVL() : base{ nullptr }, length{ 0 }, header{ nullptr }, nodes{ nullptr }
+{
+}
+
+// Destructor, unmaps the file
+MappedAVL::~MappedAVL()
+{
+	close();
+}
+
+// Maps the index file at 'path' read only and checks that it was written by AVL::save() in this format. Child offsets are
+//	not checked here, find() and range() check each one they follow
+// PRE: n/a
+// POST: returns true if the file is mapped and ready for lookups. On failure nothing stays mapped and false is returned
+bool MappedAVL::open(const std::string& path)
+{
+	close();
+
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) { return false; }
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(AVLFileHeader)) {
+		::close(fd);
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping keeps its own reference to the file
+	if (mapped == MAP_FAILED) { return false; }
+
+	base = mapped;
+	length = st.st_size;
+	header = static_cast<const AVLFileHeader*>(base);
+	nodes = reinterpret_cast<const AVLFileNode*>(header + 1);
+
+	// the version also fails on a file written with the other byte order, and the size has to match the node count exactly
+	if (std::memcmp(header->magic, AVL_FILE_MAGIC, sizeof(AVL_FILE_MAGIC)) != 0 || header->version != AVL_FILE_VERSION ||
+		length != sizeof(AVLFileHeader) + static_cast<size_t>(header->nodes) * sizeof(AVLFileNode) ||
+		header->levels > header->nodes || (header->nodes > 0 && header->levels == 0)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+// Unmaps the file if one is open
+// PRE: n/a
+// POST: isOpen() is false
+void MappedAVL::close()
+{
+	if (base != nullptr) { munmap(const_cast<void*>(base), length); }
+	base = nullptr;
+	length = 0;
+	header = nullptr;
+	nodes = nullptr;
+}
+
+// PRE: n/a
+// POST: returns true if a valid index file is mapped
+bool MappedAVL::isOpen() const
+{
+	return base != nullptr;
+}
+
+// Follows a child offset of node 'i', the file is not trusted so an offset that does not point forward to a node inside it is
+//	treated as no child
+// PRE: 'i' < header->nodes
+// POST: returns the child, nullptr if there is none or the offset is corrupt
+const AVLFileNode* MappedAVL::child(uint32_t i, int32_t offset) const
+{
+	if (offset <= 0 || offset >= static_cast<int64_t>(header->nodes) - i) { return nullptr; }
+	return nodes + i + offset;
+}
+
+// Iteratively searches for 'num' from the root, following child offsets through the mapped nodes. Offsets only point forward,
+//	so the walk ends after at most 'nodes' steps even in a corrupt file, and it stops at the saved number of levels
+// PRE: n/a
+// POST: returns the node holding 'num', nullptr if it is not in the index or nothing is open
+const AVLFileNode* MappedAVL::find(int num) const
+{
+	if (nodes == nullptr || header->nodes == 0) { return nullptr; }
+
+	const AVLFileNode* curr = nodes;
+	for (uint32_t depth = 1; curr->data != num; depth++) {
+		if (depth >= header->levels) { return nullptr; }
+		curr = child(static_cast<uint32_t>(curr - nodes), (num < curr->data) ? curr->left : curr->right);
+		if (curr == nullptr) { return nullptr; }
+	}
+	return curr;
+}
+
+// PRE: n/a
+// POST: returns true if num is in the index
+bool MappedAVL::contains(int num) const
+{
+	return find(num) != nullptr;
+}
+
+// PRE: n/a
+// POST: returns the number of copies of num in the index, 0 if it is not there
+int MappedAVL::count(int num) const
+{
+	const AVLFileNode* found = find(num);
+	return (found) ? found->count : 0;
+}
+
+// Recursive in-order scan that only descends into subtrees that can hold keys in [lo, hi]. Offsets are checked like in find(),
+//	and the recursion is no deeper than the saved number of levels
+// PRE: 'i' < header->nodes, 'depth' is the level of node 'i' counting the root as 1
+// POST: every key in [lo, hi] under node 'i' is appended to 'out' in ascending order, once per copy
+void MappedAVL::range(uint32_t i, uint32_t depth, int lo, int hi, std::vector<int>& out) const
+{
+	const AVLFileNode* curr = nodes + i;
+	const AVLFileNode* left = (depth < header->levels) ? child(i, curr->left) : nullptr;
+	const AVLFileNode* right = (depth < header->levels) ? child(i, curr->right) : nullptr;
+
+	if (lo < curr->data && left) { range(static_cast<uint32_t>(left - nodes), depth + 1, lo, hi, out); }
+	if (lo <= curr->data && curr->data <= hi && curr->count > 0) { out.insert(out.end(), curr->count, curr->data); }
+	if (curr->data < hi && right) { range(static_cast<uint32_t>(right - nodes), depth + 1, lo, hi, out); }
+}
+
+// Appends the keys in [lo, hi] to 'out' in ascending order, runs in O(log n + k) for k keys in the range
+// PRE: n/a
+// POST: 'out' keeps its old contents, nothing is appended if lo > hi or nothing is open
+void MappedAVL::range(int lo, int hi, std::vector<int>& out) const
+{
+	if (nodes == nullptr || header->nodes == 0 || lo > hi) { return; }
+	range(0, 1, lo, hi, out);
+}
+
+// PRE: n/a
+// POST: returns the number of keys in the index counting every copy, 0 if nothing is open
+int MappedAVL::size() const
+{
+	return (header) ? static_cast<int>(header->keys) : 0;
+}
+
+// PRE: n/a
+// POST: returns the height the tree had when it was saved, -1 for an empty index or if nothing is open
+int MappedAVL::height() const
+{
+	return (header) ? static_cast<int>(header->levels) - 1 : -1;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk layout written by AVL::save(). The file is a header followed by every node of the tree in breadth first order, so the
+// root is node 0 and the top levels of the tree sit together in the first pages. Children are stored as offsets in nodes relative
+// to their parent instead of pointers, which makes the file position independent: it can be mapped anywhere, by many processes.
+struct AVLFileHeader {
+	char magic[4];      // "AVLI"
+	uint32_t version;   // read as 0x01000000 on a machine with the other byte order, so open() turns such files away
+	uint32_t nodes;     // nodes that follow the header
+	uint32_t levels;    // height of the tree + 1, 0 for an empty tree
+	uint64_t keys;      // keys in the tree counting every copy of a duplicate, what AVL::size() returned
+};
+
+struct AVLFileNode {
+	int32_t data;
+	int32_t count;      // copies of 'data'
+	int32_t left;       // offset from this node to its left child, 0 for none (a child always comes after its parent, so > 0)
+	int32_t right;
+};
+
+const char AVL_FILE_MAGIC[4] = { 'A', 'V', 'L', 'I' };
+const uint32_t AVL_FILE_VERSION = 1;
+
+// Read-only view of a file written by AVL::save(). open() maps the file and answers lookups and range scans straight from the
+// mapped pages, nothing is deserialized, so opening an index of any size is O(1) and the page cache is shared between every
+// process that maps the same file. POSIX only (mmap).
+class MappedAVL {
+private:
+	const void* base;   // start of the mapping, nullptr when nothing is open
+	size_t length;
+	const AVLFileHeader* header;
+	const AVLFileNode* nodes;
+
+	const AVLFileNode* child(uint32_t i, int32_t offset) const;
+	void range(uint32_t i, uint32_t depth, int lo, int hi, std::vector<int>& out) const;
+	const AVLFileNode* find(int num) const;
+
+public:
+	MappedAVL();
+	~MappedAVL();
+	MappedAVL(const MappedAVL&) = delete;
+	MappedAVL& operator=(const MappedAVL&) = delete;
+
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const;
+
+	bool contains(int num) const;
+	int count(int num) const;
+	void range(int lo, int hi, std::vector<int>& out) const;
+
+	int size() const;
+	int height() const;
+};
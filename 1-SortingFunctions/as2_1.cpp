@@ -5,6 +5,7 @@
 #include <iomanip>		// for table manipulators
 #include <string>		// for std::to_string()
 #include "AVL.h"
+#include "BPlusTree.h"
 #include "as2_1.h"
 
 void SetUpVec(std::vector<int>& vec, int option);
@@ -50,6 +51,8 @@ int main() {
 	std::cout << std::left << std::setw(G_WIDTH1) << std::setfill(' ') << "Quick Sort";
 	std::cout << std::left << std::setw(G_WIDTH1) << std::setfill(' ') << "Heap Sort";
 	std::cout << std::left << std::setw(G_WIDTH2) << std::setfill(' ') << "Balanced BST";
+	std::cout << std::left << std::setw(G_WIDTH2) << std::setfill(' ') << "BST Bulk Load";
+	std::cout << std::left << std::setw(G_WIDTH1) << std::setfill(' ') << "B+ Tree";
 	std::cout << std::left << std::setw(G_WIDTH1) << std::setfill(' ') << "Radix Sort";
 	std::cout << '\n';
 
@@ -133,13 +136,28 @@ void FillInTable(int option) {
 
 	AVL avl;
 	t.Reset();
-	if		(option == 1) { for (int i = 0; i < ARRAY_SIZE; i++) { avl.insert(rand() % (RAND_MAX + 1)); } }
+	if		(option == 1) { for (int i = 0; i < ARRAY_SIZE; i++) { avl.insert(rand()); } }
 	else if (option == 2) { for (int i = 0; i < ARRAY_SIZE; i++) { avl.insert(rand() % 6); } }
 	else if (option == 3) { for (int i = 0; i < ARRAY_SIZE; i++) { avl.insert(i); } }
 	else if (option == 4) { for (int i = 0; i < ARRAY_SIZE; i++) { avl.insert(ARRAY_SIZE - i); } }
 	std::cout << std::left << std::setw(G_WIDTH2) << std::setfill(' ') << t.GetTime();
 	//avl.inOrder();
 
+	SetUpVec(vec, option);
+	t.Reset();
+	AVL bulk(vec, option == 3); // only the "Sorted:" row can skip sorting
+	std::cout << std::left << std::setw(G_WIDTH2) << std::setfill(' ') << t.GetTime();
+	//bulk.inOrder();
+
+	BPlusTree bpt;
+	t.Reset();
+	if		(option == 1) { for (int i = 0; i < ARRAY_SIZE; i++) { bpt.insert(rand()); } }
+	else if (option == 2) { for (int i = 0; i < ARRAY_SIZE; i++) { bpt.insert(rand() % 6); } }
+	else if (option == 3) { for (int i = 0; i < ARRAY_SIZE; i++) { bpt.insert(i); } }
+	else if (option == 4) { for (int i = 0; i < ARRAY_SIZE; i++) { bpt.insert(ARRAY_SIZE - i); } }
+	std::cout << std::left << std::setw(G_WIDTH1) << std::setfill(' ') << t.GetTime();
+	//bpt.inOrder();
+
 	SetUpVec(vec, option);
 	//PrintVec(vec);
 	t.Reset();
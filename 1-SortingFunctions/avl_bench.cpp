@@ -0,0 +1,104 @@
+// Multi-threaded throughput benchmark, ConcurrentAVL against AVL behind one global mutex.
+// Usage: avl_bench [max_threads] [ops_per_thread] [key_range]
+#include <iostream>		// for std::cout
+#include <iomanip>		// for table manipulators
+#include <string>		// for std::to_string()
+#include <vector>		// for std::vector
+#include <thread>		// for std::thread
+#include <mutex>		// for std::mutex
+#include <chrono>		// for chrono timer
+#include <random>		// for std::mt19937
+#include <cstdlib>		// for atoi()
+#include <algorithm>		// for std::max()
+#include "AVL.h"
+#include "ConcurrentAVL.h"
+
+const int G_WIDTH1 = 14;
+const int G_WIDTH2 = 18;
+
+// Percent of operations that are lookups and inserts, the rest are removes
+struct Mix {
+	const char* name;
+	int lookupPct;
+	int insertPct;
+};
+
+// Global lock baseline, the way the ingest threads use AVL today
+class LockedAVL {
+private:
+	AVL avl;
+	std::mutex m;
+
+public:
+	bool insert(int num) {
+		std::lock_guard<std::mutex> guard(m);
+		if (avl.contains(num)) { return false; } // keep set semantics, AVL::insert() would bump the key's count
+		avl.insert(num);
+		return true;
+	}
+	bool remove(int num) {
+		std::lock_guard<std::mutex> guard(m);
+		if (!avl.contains(num)) { return false; }
+		avl.remove(num);
+		return true;
+	}
+	bool contains(int num) {
+		std::lock_guard<std::mutex> guard(m);
+		return avl.contains(num);
+	}
+};
+
+// Fills half of the key range, then runs 'threads' threads doing 'ops' random operations each with the given mix
+// PRE: threads >= 1
+// POST: returns the throughput in millions of operations per second
+template <class Tree>
+double RunMix(const Mix& mix, int threads, int ops, int keyRange)
+{
+	Tree tree;
+	std::mt19937 fill(12345);
+	for (int i = 0; i < keyRange / 2; i++) { tree.insert(static_cast<int>(fill() % keyRange)); }
+
+	std::vector<std::thread> workers;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&tree, &mix, t, ops, keyRange] {
+			std::mt19937 gen(t * 7919 + 1);
+			for (int i = 0; i < ops; i++) {
+				int key = static_cast<int>(gen() % keyRange);
+				int op = static_cast<int>(gen() % 100);
+				if (op < mix.lookupPct) { tree.contains(key); }
+				else if (op < mix.lookupPct + mix.insertPct) { tree.insert(key); }
+				else { tree.remove(key); }
+			}
+		});
+	}
+	for (std::thread& w : workers) { w.join(); }
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+	return (static_cast<double>(threads) * ops) / elapsed.count() / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+	int maxThreads = (argc > 1) ? atoi(argv[1]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+	int ops = (argc > 2) ? atoi(argv[2]) : 200000;
+	int keyRange = (argc > 3) ? atoi(argv[3]) : 1 << 20;
+
+	const Mix mixes[] = {
+		{ "read-heavy 90/5/5", 90, 5 },
+		{ "write-heavy 0/50/50", 0, 50 },
+	};
+
+	std::cout << "keys: " << keyRange << ", ops/thread: " << ops << ", **throughput in Mops/s**\n";
+	std::cout << std::left << std::setw(G_WIDTH2 + 4) << "Mix" << std::setw(G_WIDTH1) << "Threads";
+	std::cout << std::setw(G_WIDTH2) << "ConcurrentAVL" << std::setw(G_WIDTH2) << "AVL + mutex" << '\n';
+
+	for (const Mix& mix : mixes) {
+		for (int threads = 1; threads <= maxThreads; threads *= 2) {
+			std::cout << std::left << std::setw(G_WIDTH2 + 4) << mix.name << std::setw(G_WIDTH1) << threads;
+			std::cout << std::setw(G_WIDTH2) << RunMix<ConcurrentAVL>(mix, threads, ops, keyRange);
+			std::cout << std::setw(G_WIDTH2) << RunMix<LockedAVL>(mix, threads, ops, keyRange) << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,508 @@
+// Checks AVL, BPlusTree and ConcurrentAVL against std::multiset and std::set, printing 1 for every check that passes and 0 for
+//	every one that fails.
+// Usage: avl_test
+#include <iostream>		// for std::cout
+#include <sstream>		// for capturing inOrder()
+#include <string>		// for std::string
+#include <vector>		// for std::vector
+#include <set>			// for std::multiset
+#include <algorithm>	// for std::set_intersection(), std::set_difference(), std::shuffle()
+#include <iterator>		// for std::inserter, std::istreambuf_iterator
+#include <random>		// for std::mt19937
+#include <fstream>		// for corrupting a saved index
+#include <cstdio>		// for std::remove()
+#include <cstddef>		// for offsetof()
+#include <thread>		// for std::thread
+#include <atomic>		// for std::atomic
+#include "AVL.h"
+#include "MappedAVL.h"
+#include "BPlusTree.h"
+#include "ConcurrentAVL.h"
+
+const int SMALL_KEYS = 40;		// a tree of this many keys stays below PAR_CUTOFF_HEIGHT
+const int LARGE_KEYS = 20000;	// and one of this many goes well above it
+const char* INDEX_PATH = "avl_test.idx";
+const int WRITERS = 4;			// ConcurrentAVL threads that insert and remove
+const int READERS = 2;			// and threads that only look keys up meanwhile
+const int WRITER_KEYS = 3000;	// keys each writer owns
+
+int failures = 0;
+
+// Prints whether 'ok' holds next to 'name', and counts it if it does not
+// PRE: n/a
+// POST: one line printed
+void Check(const std::string& name, bool ok)
+{
+	std::cout << name << ": " << ok << '\n';
+	if (!ok) { failures++; }
+}
+
+// Every key of 'tree' in order, duplicates repeated, read back from inOrder()
+// PRE: n/a
+// POST: returns the keys, the tree is not modified
+template <class Tree>
+std::multiset<int> Keys(const Tree& tree)
+{
+	std::ostringstream out;
+	std::streambuf* old = std::cout.rdbuf(out.rdbuf());
+	tree.inOrder();
+	std::cout.rdbuf(old);
+
+	std::multiset<int> keys;
+	std::istringstream in(out.str());
+	for (int key; in >> key; ) { keys.insert(key); }
+	return keys;
+}
+
+// True if 'tree' holds exactly the keys of 'expected', with the same number of copies of each
+// PRE: n/a
+// POST: the tree is not modified
+template <class Tree>
+bool Same(const Tree& tree, const std::multiset<int>& expected)
+{
+	return tree.size() == static_cast<int>(expected.size()) && Keys(tree) == expected;
+}
+
+// 'n' random keys out of [0, 'range'), inserted into both 'tree' and 'expected'
+// PRE: range > 0
+// POST: both hold the same keys
+template <class Tree>
+void Fill(Tree& tree, std::multiset<int>& expected, int n, int range, std::mt19937& gen)
+{
+	std::uniform_int_distribution<int> dist(0, range - 1);
+	for (int i = 0; i < n; i++) {
+		int key = dist(gen);
+		tree.insert(key);
+		expected.insert(key);
+	}
+}
+
+// unionWith(), intersectWith() and differenceWith() on two overlapping trees of 'n' keys each, counts added, the smaller count
+//	kept, and counts taken away respectively
+void TestSetOps(const std::string& name, int n, std::mt19937& gen)
+{
+	AVL a, b;
+	std::multiset<int> ea, eb;
+	Fill(a, ea, n, 2 * n, gen);
+	Fill(b, eb, n, 2 * n, gen);
+
+	std::multiset<int> eu = ea;
+	eu.insert(eb.begin(), eb.end());
+	std::multiset<int> ei, ed;
+	std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::inserter(ei, ei.end()));
+	std::set_difference(ea.begin(), ea.end(), eb.begin(), eb.end(), std::inserter(ed, ed.end()));
+
+	AVL u = a.snapshot(), ub = b.snapshot();
+	u.unionWith(ub);
+	Check(name + " union", Same(u, eu) && ub.size() == 0);
+
+	AVL i = a.snapshot(), ib = b.snapshot();
+	i.intersectWith(ib);
+	Check(name + " intersection", Same(i, ei) && ib.size() == 0);
+
+	AVL d = a.snapshot(), db = b.snapshot();
+	d.differenceWith(db);
+	Check(name + " difference", Same(d, ed) && db.size() == 0);
+
+	Check(name + " operands untouched", Same(a, ea) && Same(b, eb));
+
+	std::multiset<int> doubled = ea;
+	doubled.insert(ea.begin(), ea.end());
+	AVL su = a.snapshot(), si = a.snapshot(), sd = a.snapshot();
+	su.unionWith(su);
+	si.intersectWith(si);
+	sd.differenceWith(sd);
+	Check(name + " with itself", Same(su, doubled) && Same(si, ea) && sd.size() == 0 && Same(a, ea));
+}
+
+// split() around 'pivot' then join() with it again, against the keys of 'expected' split the same way
+// PRE: n/a
+// POST: returns true if both halves and the joined tree hold the expected keys, one copy of 'pivot' in the middle
+bool SplitJoin(const AVL& tree, const std::multiset<int>& expected, int pivot)
+{
+	AVL whole = tree.snapshot(), left, right;
+	left.insert(pivot - 1); // old contents of both halves are dropped
+	right.insert(pivot + 1);
+	bool found = whole.split(pivot, left, right);
+
+	std::multiset<int> lo(expected.begin(), expected.lower_bound(pivot));
+	std::multiset<int> hi(expected.upper_bound(pivot), expected.end());
+	bool ok = found == (expected.count(pivot) > 0) && whole.size() == 0 && Same(left, lo) && Same(right, hi);
+
+	left.join(pivot, right);
+	lo.insert(pivot);
+	lo.insert(hi.begin(), hi.end());
+	return ok && right.size() == 0 && Same(left, lo);
+}
+
+// The public split() and join() with the pivot present, present with many copies, absent, and past either end so one side is
+//	empty, on a tree with duplicates and on an empty one
+void TestJoinSplit(std::mt19937& gen)
+{
+	AVL tree;
+	std::multiset<int> expected;
+	Fill(tree, expected, 5000, 2000, gen);
+	for (int i = 0; i < 20; i++) {
+		tree.insert(1000);
+		tree.insert(1500);
+		expected.insert(1000);
+		expected.insert(1500);
+	}
+
+	int absent = 0;
+	while (expected.count(absent)) { absent++; }
+	Check("split present", SplitJoin(tree, expected, *expected.begin()) && SplitJoin(tree, expected, 1500) &&
+		SplitJoin(tree, expected, *expected.rbegin()));
+	Check("split duplicate pivot", SplitJoin(tree, expected, 1000));
+	Check("split absent", SplitJoin(tree, expected, absent));
+	Check("split empty sides", SplitJoin(tree, expected, -1) && SplitJoin(tree, expected, 2000) &&
+		SplitJoin(AVL(), std::multiset<int>(), 5));
+
+	AVL empty, small;
+	small.insert(3);
+	empty.join(1, small); // empty left side
+	AVL right;
+	empty.join(7, right); // empty right side
+	Check("join empty sides", Same(empty, std::multiset<int>{ 1, 3, 7 }) && small.size() == 0);
+}
+
+// Many copies of few keys collapse into counted nodes: insert() and the bulk constructor add copies, remove() takes one off
+//	and the node goes once none are left
+void TestDuplicates(std::mt19937& gen)
+{
+	AVL tree;
+	std::multiset<int> expected;
+	Fill(tree, expected, 5000, 50, gen);
+	Check("duplicates insert", Same(tree, expected));
+
+	std::vector<int> keys(expected.begin(), expected.end());
+	std::shuffle(keys.begin(), keys.end(), gen);
+	Check("duplicates bulk", Same(AVL(keys), expected) && Same(AVL(std::vector<int>(expected.begin(), expected.end()), true), expected));
+
+	bool ok = true;
+	for (int i = 0; i < 4000; i++) {
+		int key = keys[i];
+		tree.remove(key);
+		expected.erase(expected.find(key));
+		ok = ok && tree.contains(key) == (expected.count(key) > 0);
+	}
+	tree.remove(-1); // not in the tree
+	Check("duplicates remove", ok && Same(tree, expected));
+}
+
+// A snapshot keeps the keys it was taken with while the original is inserted into, removed from and merged, and the original
+//	is not affected when the snapshot itself is written to
+void TestSnapshot(std::mt19937& gen)
+{
+	AVL tree;
+	std::multiset<int> expected;
+	Fill(tree, expected, 3000, 1000, gen);
+
+	AVL snap = tree.snapshot();
+	std::multiset<int> frozen = expected;
+
+	std::uniform_int_distribution<int> dist(0, 999);
+	for (int i = 0; i < 2000; i++) {
+		int key = dist(gen);
+		if (i % 3 == 0) {
+			tree.remove(key);
+			if (expected.count(key)) { expected.erase(expected.find(key)); }
+		}
+		else {
+			tree.insert(key);
+			expected.insert(key);
+		}
+	}
+	AVL more;
+	std::multiset<int> moreKeys;
+	Fill(more, moreKeys, 500, 2000, gen);
+	tree.unionWith(more);
+	expected.insert(moreKeys.begin(), moreKeys.end());
+	Check("snapshot after updates", Same(snap, frozen) && Same(tree, expected));
+
+	AVL again = tree.snapshot();
+	std::multiset<int> frozenAgain = expected;
+	snap.insert(-5);
+	snap.remove(frozen.empty() ? 0 : *frozen.begin());
+	Check("snapshot written to", Same(tree, expected) && Same(again, frozenAgain));
+}
+
+// Ascending and descending runs go through the cached right and left spines, mixed with inserts at both ends, duplicates of
+//	the keys on a spine, and keys in the middle that send insert() back to the root
+void TestFingerInserts(std::mt19937& gen)
+{
+	AVL up, down;
+	std::multiset<int> expected;
+	for (int i = 0; i < LARGE_KEYS; i++) {
+		up.insert(i);
+		down.insert(LARGE_KEYS - 1 - i);
+		expected.insert(i);
+	}
+	Check("finger ascending", Same(up, expected));
+	Check("finger descending", Same(down, expected));
+
+	AVL both;
+	std::multiset<int> bothKeys;
+	std::uniform_int_distribution<int> dist(0, 99);
+	int lo = 0, hi = 0;
+	for (int i = 0; i < LARGE_KEYS; i++) {
+		int key = 0;
+		int pick = dist(gen);
+		if (pick < 40) { key = ++hi; }
+		else if (pick < 80) { key = --lo; }
+		else if (pick < 90) { key = (pick % 2 == 0) ? hi : lo; } // duplicate of the last key on a spine
+		else { key = lo + (hi - lo) / 2; }
+		both.insert(key);
+		bothKeys.insert(key);
+	}
+	Check("finger both ends", Same(both, bothKeys));
+
+	std::vector<int> tail, head, middle;
+	for (int i = 1; i <= 1000; i++) {
+		tail.push_back(hi + i);
+		head.push_back(lo - 1001 + i);
+		middle.push_back(lo + 2 * i);
+	}
+	both.insertSorted(tail);
+	both.insertSorted(head);
+	both.insertSorted(middle);
+	bothKeys.insert(tail.begin(), tail.end());
+	bothKeys.insert(head.begin(), head.end());
+	bothKeys.insert(middle.begin(), middle.end());
+	Check("finger sorted batches", Same(both, bothKeys));
+}
+
+// Overwrites the bytes at 'pos' of the file at 'path' with 'value'
+// PRE: the file is at least pos + sizeof(value) bytes long
+// POST: the rest of the file is unchanged
+template <class T>
+void Patch(const char* path, std::streamoff pos, const T& value)
+{
+	std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(pos);
+	file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// save() then MappedAVL::open() gives back the same keys through count() and range(), and files that are cut short, written
+//	with the other byte order or hold child offsets pointing outside the file are turned away or read without leaving it
+void TestMapped(std::mt19937& gen)
+{
+	AVL tree;
+	std::multiset<int> expected;
+	Fill(tree, expected, LARGE_KEYS, LARGE_KEYS, gen);
+
+	MappedAVL mapped;
+	bool opened = tree.save(INDEX_PATH) && mapped.open(INDEX_PATH);
+	Check("mapped open", opened && mapped.size() == static_cast<int>(expected.size()) && mapped.height() >= 0);
+
+	bool ok = opened;
+	for (int key = -1; key <= LARGE_KEYS && ok; key++) {
+		ok = mapped.count(key) == static_cast<int>(expected.count(key)) && mapped.contains(key) == (expected.count(key) > 0);
+	}
+	Check("mapped find", ok);
+
+	std::uniform_int_distribution<int> dist(-10, LARGE_KEYS + 10);
+	for (int i = 0; i < 200 && ok; i++) {
+		int lo = dist(gen);
+		int hi = lo + dist(gen) / 10;
+		std::vector<int> got;
+		mapped.range(lo, hi, got);
+		ok = got == std::vector<int>(expected.lower_bound(lo), expected.upper_bound(hi));
+	}
+	std::vector<int> all;
+	mapped.range(1, 0, all);
+	Check("mapped range", ok && all.empty());
+	mapped.close();
+
+	AVL empty;
+	Check("mapped empty", empty.save(INDEX_PATH) && mapped.open(INDEX_PATH) && mapped.size() == 0 && mapped.height() == -1 &&
+		!mapped.contains(0));
+	mapped.close();
+
+	tree.save(INDEX_PATH);
+	std::streamoff firstNode = sizeof(AVLFileHeader);
+	std::vector<char> bytes;
+	{
+		std::ifstream in(INDEX_PATH, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream out(INDEX_PATH, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - sizeof(AVLFileNode)));
+	}
+	bool shortRejected = !mapped.open(INDEX_PATH);
+
+	tree.save(INDEX_PATH);
+	Patch(INDEX_PATH, offsetof(AVLFileHeader, version), static_cast<uint32_t>(AVL_FILE_VERSION << 24));
+	Check("mapped rejects bad files", shortRejected && !mapped.open(INDEX_PATH));
+
+	tree.save(INDEX_PATH);
+	Patch(INDEX_PATH, firstNode + offsetof(AVLFileNode, left), static_cast<int32_t>(LARGE_KEYS * 4));
+	Patch(INDEX_PATH, firstNode + offsetof(AVLFileNode, right), static_cast<int32_t>(-1));
+	std::vector<int> none;
+	bool corruptOk = mapped.open(INDEX_PATH);
+	if (corruptOk) { mapped.range(-10, LARGE_KEYS + 10, none); }
+	int root = (corruptOk && !none.empty()) ? none.front() : 0;
+	Check("mapped bad offsets", corruptOk && none.size() == expected.count(root) && !mapped.contains(root - 1) &&
+		!mapped.contains(root + 1));
+	mapped.close();
+
+	std::remove(INDEX_PATH);
+}
+
+// True if contains() agrees with 'expected' for every key in [lo, hi]
+// PRE: n/a
+// POST: the tree is not modified
+bool Contains(const BPlusTree& tree, const std::multiset<int>& expected, int lo, int hi)
+{
+	for (int key = lo; key <= hi; key++) {
+		if (tree.contains(key) != (expected.count(key) > 0)) { return false; }
+	}
+	return true;
+}
+
+// BPlusTree with enough keys for inner nodes to split, runs of one key that span several 60 key leaves, negative keys for the
+//	signed SSE2 compares in countLess() and countLessEqual(), removes that borrow and merge across separators equal to the key
+//	removed, and copies that stay apart from the original
+void TestBPlusTree(std::mt19937& gen)
+{
+	BPlusTree tree;
+	std::multiset<int> expected;
+	std::uniform_int_distribution<int> dist(-LARGE_KEYS, LARGE_KEYS);
+	for (int i = 0; i < 3 * LARGE_KEYS; i++) {
+		int key = dist(gen);
+		tree.insert(key);
+		expected.insert(key);
+	}
+	Check("bplus insert", Same(tree, expected) && Contains(tree, expected, -LARGE_KEYS - 2, LARGE_KEYS + 2));
+
+	BPlusTree dups;
+	std::multiset<int> dupKeys;
+	for (int i = 0; i < 400; i++) {
+		for (int key = -2; key <= 2; key++) { // 400 copies each, about 7 leaves per key
+			dups.insert(key * 10);
+			dupKeys.insert(key * 10);
+		}
+	}
+	Check("bplus duplicate runs", Same(dups, dupKeys) && Contains(dups, dupKeys, -25, 25));
+
+	bool ok = true;
+	std::uniform_int_distribution<int> dupDist(-2, 2);
+	for (int i = 0; i < 1800; i++) {
+		int key = dupDist(gen) * 10;
+		dups.remove(key);
+		if (dupKeys.count(key)) { dupKeys.erase(dupKeys.find(key)); }
+		ok = ok && dups.contains(key) == (dupKeys.count(key) > 0);
+	}
+	dups.remove(5); // not in the tree
+	Check("bplus duplicate removes", ok && Same(dups, dupKeys) && Contains(dups, dupKeys, -25, 25));
+
+	BPlusTree copy(tree);
+	BPlusTree assigned;
+	assigned.insert(7);
+	assigned = tree;
+	assigned = assigned;
+	std::multiset<int> frozen = expected;
+
+	std::vector<int> keys(expected.begin(), expected.end());
+	std::shuffle(keys.begin(), keys.end(), gen);
+	ok = true;
+	for (size_t i = 0; i < keys.size(); i++) {
+		tree.remove(keys[i]);
+		expected.erase(expected.find(keys[i]));
+		if (i % 5000 == 0) { ok = ok && Same(tree, expected); }
+	}
+	Check("bplus remove all", ok && tree.size() == 0 && Same(tree, expected) && !tree.contains(keys[0]));
+
+	copy.insert(LARGE_KEYS + 1);
+	Check("bplus copies", Same(assigned, frozen) && copy.size() == static_cast<int>(frozen.size()) + 1 &&
+		copy.contains(LARGE_KEYS + 1) && !assigned.contains(LARGE_KEYS + 1));
+
+	for (int i = 0; i < LARGE_KEYS; i++) { tree.insert(LARGE_KEYS - i); } // refill the emptied tree, descending
+	std::multiset<int> refill;
+	for (int i = 0; i < LARGE_KEYS; i++) { refill.insert(i + 1); }
+	Check("bplus refill", Same(tree, refill));
+}
+
+// ConcurrentAVL with writers inserting ascending runs of their own keys, which keeps rotating the tree, and removing them again in
+//	random order, more than RECLAIM_BATCH times each so retired nodes are freed while readers are still in the tree. Writer t
+//	owns the keys 4 * (k * WRITERS + t), so every insert() and remove() result is known. Keys 4m + 2 are inserted up front and
+//	never removed, odd keys are never inserted, and the readers check both the whole time
+void TestConcurrentAVL()
+{
+	ConcurrentAVL tree;
+	const int stableKeys = WRITERS * WRITER_KEYS;
+	for (int m = 0; m < stableKeys; m++) { tree.insert(4 * m + 2); }
+
+	std::atomic<int> writing{ WRITERS };
+	std::atomic<bool> readsOk{ true };
+	std::atomic<long long> reads{ 0 };
+	std::vector<std::set<int>> owned(WRITERS);
+	std::vector<char> writesOk(WRITERS, 1);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < WRITERS; t++) {
+		threads.emplace_back([&, t] {
+			std::mt19937 gen(t + 1);
+			std::vector<int> keys;
+			for (int k = 0; k < WRITER_KEYS; k++) { keys.push_back(4 * (k * WRITERS + t)); }
+
+			for (int round = 0; round < 3; round++) {
+				for (int key : keys) { // ascending, rebalanced all the way up the right side
+					bool added = tree.insert(key);
+					if (added == (owned[t].count(key) > 0)) { writesOk[t] = 0; }
+					owned[t].insert(key);
+				}
+				std::vector<int> order = keys;
+				std::shuffle(order.begin(), order.end(), gen);
+				order.resize((round < 2) ? order.size() : order.size() / 2); // the last round keeps half
+				for (int key : order) {
+					if (!tree.remove(key) || tree.remove(key)) { writesOk[t] = 0; } // second remove finds nothing
+					owned[t].erase(key);
+				}
+			}
+			writing--;
+		});
+	}
+	for (int r = 0; r < READERS; r++) {
+		threads.emplace_back([&, r] {
+			std::mt19937 gen(100 + r);
+			std::uniform_int_distribution<int> dist(0, stableKeys - 1);
+			long long n = 0;
+			while (writing > 0) {
+				int m = dist(gen);
+				if (!tree.contains(4 * m + 2) || tree.contains(4 * m + 1)) { readsOk = false; }
+				n++;
+			}
+			reads += n;
+		});
+	}
+	for (std::thread& th : threads) { th.join(); }
+
+	std::set<int> expected;
+	for (int m = 0; m < stableKeys; m++) { expected.insert(4 * m + 2); }
+	bool ok = true;
+	for (int t = 0; t < WRITERS; t++) {
+		ok = ok && writesOk[t];
+		expected.insert(owned[t].begin(), owned[t].end());
+	}
+	Check("concurrent inserts and removes", ok && Same(tree, std::multiset<int>(expected.begin(), expected.end())));
+	Check("concurrent lookups", readsOk && reads > 0);
+}
+
+int main()
+{
+	std::mt19937 gen(2024);
+
+	TestSetOps("small", SMALL_KEYS, gen);
+	TestSetOps("large", LARGE_KEYS, gen);
+	TestJoinSplit(gen);
+	TestDuplicates(gen);
+	TestSnapshot(gen);
+	TestFingerInserts(gen);
+	TestMapped(gen);
+	TestBPlusTree(gen);
+	TestConcurrentAVL();
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -1,5 +1,5 @@
 
-all: test1 test2 test3 test4
+all: test1 test2 test3 test4 test5 test6 test7 test8 test9 test10 test11 test12 test13 test14 dijkstra_bench dheap_bench meld_bench multiqueue_bench merge_bench heap_bench timer_bench
 
 test1: test1.o 
 	g++ -o test1 test1.o 
@@ -12,6 +12,57 @@ test3: test3.o
 
 test4: test4.o
 	g++ -o test4 test4.o 
+
+test5: test5.o
+	g++ -o test5 test5.o 
+
+test6: test6.o
+	g++ -o test6 test6.o 
+
+test7: test7.o
+	g++ -o test7 test7.o 
+
+test8: test8.o
+	g++ -o test8 test8.o 
+
+test9: test9.o
+	g++ -o test9 test9.o 
+
+test10: test10.o
+	g++ -o test10 test10.o 
+
+test11: test11.o
+	g++ -pthread -o test11 test11.o 
+
+test12: test12.o
+	g++ -o test12 test12.o 
+
+test13: test13.o
+	g++ -o test13 test13.o 
+
+test14: test14.o
+	g++ -o test14 test14.o 
+
+dijkstra_bench: dijkstra_bench.cpp heap.h indexedheap.h radixheap.h
+	g++ -O2 -o dijkstra_bench dijkstra_bench.cpp 
+
+dheap_bench: dheap_bench.cpp heap.h dheap.h
+	g++ -O2 -o dheap_bench dheap_bench.cpp 
+
+meld_bench: meld_bench.cpp heap.h pairingheap.h
+	g++ -O2 -o meld_bench meld_bench.cpp 
+
+multiqueue_bench: multiqueue_bench.cpp heap.h multiqueue.h
+	g++ -O2 -pthread -o multiqueue_bench multiqueue_bench.cpp 
+
+merge_bench: merge_bench.cpp heap.h losertree.h
+	g++ -O2 -o merge_bench merge_bench.cpp 
+
+heap_bench: heap_bench.cpp heap.h
+	g++ -O2 -o heap_bench heap_bench.cpp 
+
+timer_bench: timer_bench.cpp heap.h indexedheap.h timerwheel.h
+	g++ -O2 -o timer_bench timer_bench.cpp 
 	
 test1.o: test1.cpp heap.h
 	g++ -c test1.cpp 
@@ -25,8 +76,41 @@ test3.o: test3.cpp heap.h
 test4.o: test4.cpp heap.h
 	g++ -c test4.cpp 
 
+test5.o: test5.cpp heap.h
+	g++ -c test5.cpp 
+
+test6.o: test6.cpp heap.h
+	g++ -c test6.cpp 
+
+test7.o: test7.cpp indexedheap.h
+	g++ -c test7.cpp 
+
+test8.o: test8.cpp dheap.h
+	g++ -c test8.cpp 
+
+test9.o: test9.cpp pairingheap.h
+	g++ -c test9.cpp 
+
+test10.o: test10.cpp radixheap.h
+	g++ -c test10.cpp 
+
+test11.o: test11.cpp heap.h multiqueue.h
+	g++ -pthread -c test11.cpp 
+
+test12.o: test12.cpp heap.h
+	g++ -c test12.cpp 
+
+test13.o: test13.cpp losertree.h
+	g++ -c test13.cpp 
+
+test14.o: test14.cpp heap.h indexedheap.h timerwheel.h
+	g++ -c test14.cpp 
+
 clean:
-	rm -f test1 test2 test3 test4 *.o  
+	rm -f test1 test2 test3 test4 test5 test6 test7 test8 test9 test10 test11 test12 test13 test14 dijkstra_bench dheap_bench meld_bench multiqueue_bench merge_bench heap_bench timer_bench heap_bench.csv *.o  
+
+bench: heap_bench
+	./heap_bench | tee heap_bench.csv
 
 t1:
 	./test1
@@ -39,6 +123,36 @@ t3:
 	
 t4:
 	./test4
+
+t5:
+	./test5
+
+t6:
+	./test6
+
+t7:
+	./test7
+
+t8:
+	./test8
+
+t9:
+	./test9
+
+t10:
+	./test10
+
+t11:
+	./test11
+
+t12:
+	./test12
+
+t13:
+	./test13
+
+t14:
+	./test14
 	
 vg1:
 	valgrind --leak-check=full --show-leak-kinds=all ./test1
@@ -51,3 +165,33 @@ vg3:
 	
 vg4:
 	valgrind --leak-check=full --show-leak-kinds=all ./test4
+	
+vg5:
+	valgrind --leak-check=full --show-leak-kinds=all ./test5
+	
+vg6:
+	valgrind --leak-check=full --show-leak-kinds=all ./test6
+	
+vg7:
+	valgrind --leak-check=full --show-leak-kinds=all ./test7
+	
+vg8:
+	valgrind --leak-check=full --show-leak-kinds=all ./test8
+	
+vg9:
+	valgrind --leak-check=full --show-leak-kinds=all ./test9
+	
+vg10:
+	valgrind --leak-check=full --show-leak-kinds=all ./test10
+	
+vg11:
+	valgrind --leak-check=full --show-leak-kinds=all ./test11
+	
+vg12:
+	valgrind --leak-check=full --show-leak-kinds=all ./test12
+	
+vg13:
+	valgrind --leak-check=full --show-leak-kinds=all ./test13
+	
+vg14:
+	valgrind --leak-check=full --show-leak-kinds=all ./test14
@@ -0,0 +1,260 @@
+/******************************************************
+  DHeap.h -- Declarations for Templated d-ary Heap Class
+
+  Stores pairs <element,priority> like Heap, for any Priority and Element
+  types, with a compile-time arity D (2, 4 or 8 are the useful ones) and a
+  Compare that says which priority comes first (std::less: min-heap).
+  Priorities and elements are kept in two separate arrays, so sifting reads
+  and writes only the priorities plus one element per level, and trickling
+  moves a hole instead of swapping pairs. A wider heap is shallower, and its
+  D children sit next to each other in the priority array, so a sift down
+  touches about log_D(n) cache lines instead of log_2(n). For D = 8 with int
+  priorities the smallest child is found with SSE2 compares.
+  Supports O(log n) insertion and extraction, O(1) peeking, O(n) heapify.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DHEAP_USE_SSE2
+#endif
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+
+template <class Priority, class Element, int D = 4, class Compare = less<Priority> >
+class DHeap{
+   static_assert( D >= 2, "a heap needs at least 2 children per node" );
+
+public:
+   // Constructors
+
+   // New empty DHeap.
+   DHeap( const Compare & cmp = Compare() );
+
+   // New empty DHeap with room for c pairs before it has to grow.
+   DHeap( int c, const Compare & cmp = Compare() );
+
+   // New DHeap with size s, consisting of pairs <Pi,Ei> where, 
+   // for 0 <= i < s, Pi is Priorities[i] and Ei is value Elements[i].
+   // Built with heapify() in O(s).
+   DHeap( const Priority * Priorities, const Element * Elements, int s, const Compare & cmp = Compare() );
+
+   // Accessors
+   bool empty() const { return P.empty(); } // True iff DHeap is empty.
+   int size() const { return static_cast<int>(P.size()); } // Current size of DHeap.
+   const Element & peekMin() const { return E[0]; } // Peek at first element. Requires: !empty().
+   const Priority & peekMinPriority() const { return P[0]; } // Peek at first priority. Requires: !empty().
+
+   // Modifiers
+   void insert( const Element & element, const Priority & priority ); // Insert the pair <element,priority>.
+   // Remove the first element (and its priority) and store it. Returns false if empty.
+   bool extractMin( Element & element );
+   bool extractMin( Element & element, Priority & priority );
+   void reserve( int c ); // Make room for c pairs.
+   void clear(); // Remove everything, keeping the memory.
+
+private:
+   vector<Priority> P ; // Priorities, P[i] goes with E[i]. Children of i are D*i+1 .. D*i+D.
+   vector<Element> E ; // Elements.
+   Compare before ; // before(a,b) is true if priority a comes out before b.
+
+   // Moves the hole at i up until <element,priority> fits there.
+   void trickleUp( int i, Priority priority, Element element );
+
+   // Moves the hole at i down until <element,priority> fits there.
+   void trickleDown( int i, Priority priority, Element element );
+
+   // Index of the first of the n children starting at 'first'.
+   int firstChild( int first, int n ) const;
+
+   // Establishes ordering invariant for entire array contents.
+   void heapify();
+};
+
+#ifdef DHEAP_USE_SSE2
+static const int DHEAP_LOW_BIT[16] = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 }; // lowest set bit of a 4 bit movemask
+
+// Lane-wise minimum of 4 ints, a single instruction with SSE4.1, compare and blend with plain SSE2
+inline __m128i dheapMin(__m128i a, __m128i b)
+{
+#ifdef __SSE4_1__
+	return _mm_min_epi32(a, b);
+#else
+	__m128i aLess = _mm_cmplt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(aLess, a), _mm_andnot_si128(aLess, b));
+#endif
+}
+
+// Index of the smallest of the 8 ints at p[0] .. p[7], the first one on ties. Branch free apart from picking the half:
+//	two loads, a tree of mins that leaves the minimum in every lane, then compare it back against both halves
+inline int dheapMinOf8(const int* p)
+{
+	__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4));
+	__m128i m = dheapMin(lo, hi);
+	m = dheapMin(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+	m = dheapMin(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	int loMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lo, m)));
+	if (loMask) { return DHEAP_LOW_BIT[loMask]; }
+	return 4 + DHEAP_LOW_BIT[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(hi, m)))];
+}
+#endif
+
+// default constructor
+template <class Priority, class Element, int D, class Compare>
+DHeap<Priority, Element, D, Compare>::DHeap(const Compare& cmp)
+	: before{ cmp }
+{
+}
+
+// constructor which reserves room for c pairs
+template <class Priority, class Element, int D, class Compare>
+DHeap<Priority, Element, D, Compare>::DHeap(int c, const Compare& cmp)
+	: before{ cmp }
+{
+	reserve(c);
+}
+
+// New DHeap constructor with s pairs <Priorities[i],Elements[i]>, copied in as they are and heapified once
+template <class Priority, class Element, int D, class Compare>
+DHeap<Priority, Element, D, Compare>::DHeap(const Priority* Priorities, const Element* Elements, int s, const Compare& cmp)
+	: P(Priorities, Priorities + s), E(Elements, Elements + s), before{ cmp }
+{
+	heapify();
+}
+
+// Modifiers
+
+// adds a hole at the end and moves it up to where the new pair belongs
+// PRE: n/a
+// POST: new pair placed according to priority
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::insert(const Element& element, const Priority& priority)
+{
+	P.push_back(priority);
+	E.push_back(element);
+	trickleUp(size() - 1, priority, element);
+}
+
+// Removes the element with the first priority and stores it in 'element'.
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if the heap is empty
+template <class Priority, class Element, int D, class Compare>
+bool DHeap<Priority, Element, D, Compare>::extractMin(Element& element)
+{
+	Priority priority;
+	return extractMin(element, priority);
+}
+
+// Removes the element with the first priority and stores it and its priority. The last pair is taken out of the
+// array and the hole left at the root is moved down until that pair fits, one move per level instead of a swap.
+// PRE: n/a
+// POST: returns false and leaves both arguments alone if the heap is empty
+template <class Priority, class Element, int D, class Compare>
+bool DHeap<Priority, Element, D, Compare>::extractMin(Element& element, Priority& priority)
+{
+	if (P.empty()) { return false; }
+
+	element = std::move(E[0]);
+	priority = std::move(P[0]);
+
+	Priority lastP = std::move(P.back());
+	Element lastE = std::move(E.back());
+	P.pop_back();
+	E.pop_back();
+	if (!P.empty()) { trickleDown(0, std::move(lastP), std::move(lastE)); }
+	return true;
+}
+
+// PRE: n/a
+// POST: capacity of both arrays is at least c
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::reserve(int c)
+{
+	P.reserve(c);
+	E.reserve(c);
+}
+
+// PRE: n/a
+// POST: heap is empty, memory is kept for reuse
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::clear()
+{
+	P.clear();
+	E.clear();
+}
+
+// Moves parents down into the hole at i while the new pair comes before them, then fills the hole
+// PRE: index i is valid, its contents are about to be overwritten
+// POST: <element,priority> is at its place on the path from i to the root
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::trickleUp(int i, Priority priority, Element element)
+{
+	while (i > 0) {
+		int pInd{ (i - 1) / D };
+		if (!before(priority, P[pInd])) { break; }
+		P[i] = std::move(P[pInd]);
+		E[i] = std::move(E[pInd]);
+		i = pInd;
+	}
+	P[i] = std::move(priority);
+	E[i] = std::move(element);
+}
+
+// Moves the first child up into the hole at i while it comes before the pair being placed, then fills the hole
+// PRE: index i is valid, its contents are about to be overwritten
+// POST: subtree rooted at i is in heap form with <element,priority> in it
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::trickleDown(int i, Priority priority, Element element)
+{
+	int n = size();
+	while (true) {
+		int first = D * i + 1;
+		if (first >= n) { break; }
+
+		int c = firstChild(first, min(D, n - first));
+		if (!before(P[c], priority)) { break; }
+		P[i] = std::move(P[c]);
+		E[i] = std::move(E[c]);
+		i = c;
+	}
+	P[i] = std::move(priority);
+	E[i] = std::move(element);
+}
+
+// Finds which of the n siblings P[first] .. P[first + n - 1] comes first, scanning left to right so ties keep the leftmost
+// PRE: 1 <= n <= D, all n indexes are valid
+// POST: returns the index of the first child
+template <class Priority, class Element, int D, class Compare>
+int DHeap<Priority, Element, D, Compare>::firstChild(int first, int n) const
+{
+#ifdef DHEAP_USE_SSE2
+	if (D == 8 && n == 8 && is_same<Priority, int>::value && is_same<Compare, less<int> >::value) {
+		return first + dheapMinOf8(reinterpret_cast<const int*>(&P[first]));
+	}
+#endif
+	int best = first;
+	for (int c = first + 1; c < first + n; c++) {
+		if (before(P[c], P[best])) { best = c; }
+	}
+	return best;
+}
+
+// Turns the arrays into a heap by trickling down every internal node, last one first.
+template <class Priority, class Element, int D, class Compare>
+void DHeap<Priority, Element, D, Compare>::heapify()
+{
+	for (int i = (size() - 2) / D; i >= 0 && size() > 1; i--) {
+		Priority p = std::move(P[i]);
+		Element e = std::move(E[i]);
+		trickleDown(i, std::move(p), std::move(e));
+	}
+}
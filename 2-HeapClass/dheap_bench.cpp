@@ -0,0 +1,63 @@
+/*************************************************************
+   Heap against DHeap of arity 2, 4 and 8 on a heap larger than
+   the L2 cache: n random inserts followed by n extractMins.
+   Usage: dheap_bench [n]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "heap.h"
+#include "dheap.h"
+using namespace std;
+
+const int G_WIDTH = 16 ;
+
+// Times inserting every pair and then extracting them all, returns false if they did not come out in order.
+template <class H>
+bool run( H & heap, const vector<int> & pri, double & tInsert, double & tExtract ){
+      int n = (int)pri.size() ;
+      auto start = chrono::high_resolution_clock::now();
+      for( int i = 0 ; i < n ; i++ ) heap.insert( i, pri[i] );
+      auto mid = chrono::high_resolution_clock::now();
+      int last = -1 ;
+      bool ordered = true ;
+      for( int i = 0 ; i < n ; i++ ){
+         int p = heap.peekMinPriority() ;
+         int e ;
+         heap.extractMin(e);
+         if( p < last ) ordered = false ;
+         last = p ;
+      }
+      auto end = chrono::high_resolution_clock::now();
+      tInsert = chrono::duration<double>(mid - start).count();
+      tExtract = chrono::duration<double>(end - mid).count();
+      return ordered ;
+}
+
+template <class H>
+void row( const char * name, H & heap, const vector<int> & pri ){
+      double tInsert, tExtract ;
+      bool ok = run( heap, pri, tInsert, tExtract );
+      cout << left << setw(G_WIDTH) << name << setw(G_WIDTH) << tInsert << setw(G_WIDTH) << tExtract ;
+      cout << (ok ? "" : "OUT OF ORDER") << endl ;
+}
+
+int main( int argc, char * argv[] ){
+      int n = (argc > 1) ? atoi(argv[1]) : 1 << 23 ;
+
+      mt19937 gen(36);
+      vector<int> pri(n);
+      for( int i = 0 ; i < n ; i++ ) pri[i] = (int)(gen() >> 1);
+
+      cout << "n: " << n << ", seconds" << endl ;
+      cout << left << setw(G_WIDTH) << "Queue" << setw(G_WIDTH) << "insert" << setw(G_WIDTH) << "extractMin" << endl ;
+
+      { Heap H(n) ; row( "Heap", H, pri ); }
+      { DHeap<int,int,2> H(n) ; row( "DHeap<2>", H, pri ); }
+      { DHeap<int,int,4> H(n) ; row( "DHeap<4>", H, pri ); }
+      { DHeap<int,int,8> H(n) ; row( "DHeap<8>", H, pri ); }
+      return 0 ;
+}
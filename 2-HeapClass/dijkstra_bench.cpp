@@ -0,0 +1,126 @@
+/*************************************************************
+   Shortest path benchmark, Heap with duplicate pushes against
+   IndexedHeap with decreaseKey, and the monotone queues RadixHeap
+   and BucketQueue with duplicate pushes, on a random directed graph.
+   Usage: dijkstra_bench [vertices] [average out-degree] [runs]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <climits>
+#include "heap.h"
+#include "indexedheap.h"
+#include "radixheap.h"
+using namespace std;
+
+// Graph in compressed sparse row form, the edges leaving v are edges[first[v]] .. edges[first[v+1]-1].
+struct Graph {
+      vector<int> first ;
+      vector<int> to ;
+      vector<int> weight ;
+};
+
+// Random graph with a path 0 -> 1 -> ... -> n-1 so every vertex is reachable,
+// plus n*(degree-1) edges between random vertices, weights 1 .. 1000.
+Graph makeGraph( int n, int degree ){
+      mt19937 gen(35);
+      vector< vector< pair<int,int> > > adj(n);
+      for( int v = 0 ; v + 1 < n ; v++ ) adj[v].push_back( make_pair( v + 1, 1 + (int)(gen() % 1000) ) );
+      for( long long e = 0 ; e < (long long)n * (degree - 1) ; e++ ){
+         adj[gen() % n].push_back( make_pair( (int)(gen() % n), 1 + (int)(gen() % 1000) ) );
+      }
+
+      Graph G ;
+      G.first.push_back(0);
+      for( int v = 0 ; v < n ; v++ ){
+         for( const pair<int,int> & e : adj[v] ){ G.to.push_back(e.first); G.weight.push_back(e.second); }
+         G.first.push_back( (int)G.to.size() );
+      }
+      return G ;
+}
+
+// Lazy deletion: every improvement pushes another copy, stale copies are skipped when popped.
+// Works with any queue with Heap's insert/extractMin, H starts empty.
+template <class Q>
+vector<int> dijkstraLazy( const Graph & G, int source, Q H, int & peak ){
+      int n = (int)G.first.size() - 1 ;
+      vector<int> dist( n, INT_MAX );
+      vector<bool> done( n, false );
+      dist[source] = 0 ;
+      H.insert( source, 0 );
+      peak = 1 ;
+      int v ;
+      while( H.extractMin(v) ){
+         if( done[v] ) continue ; // stale copy
+         done[v] = true ;
+         for( int i = G.first[v] ; i < G.first[v+1] ; i++ ){
+            int u = G.to[i] ;
+            if( dist[v] + G.weight[i] < dist[u] ){
+               dist[u] = dist[v] + G.weight[i] ;
+               H.insert( u, dist[u] );
+            }
+         }
+         if( H.size() > peak ) peak = H.size() ;
+      }
+      return dist ;
+}
+
+// Indexed: each vertex is in the heap at most once and improvements call decreaseKey.
+vector<int> dijkstraIndexed( const Graph & G, int source, int & peak ){
+      int n = (int)G.first.size() - 1 ;
+      vector<int> dist( n, INT_MAX );
+      IndexedHeap H(n);
+      dist[source] = 0 ;
+      H.insert( source, 0 );
+      peak = 1 ;
+      int v ;
+      while( H.extractMin(v) ){
+         for( int i = G.first[v] ; i < G.first[v+1] ; i++ ){
+            int u = G.to[i] ;
+            if( dist[v] + G.weight[i] < dist[u] ){
+               bool seen = dist[u] != INT_MAX ;
+               dist[u] = dist[v] + G.weight[i] ;
+               if( seen ) H.decreaseKey( u, dist[u] );
+               else H.insert( u, dist[u] );
+            }
+         }
+         if( H.size() > peak ) peak = H.size() ;
+      }
+      return dist ;
+}
+
+int main( int argc, char * argv[] ){
+      int n = (argc > 1) ? atoi(argv[1]) : 1000000 ;
+      int degree = (argc > 2) ? atoi(argv[2]) : 8 ;
+      int runs = (argc > 3) ? atoi(argv[3]) : 3 ;
+
+      Graph G = makeGraph( n, degree );
+      cout << "vertices: " << n << ", edges: " << G.to.size() << ", runs: " << runs << endl ;
+      cout << left << setw(18) << "Queue" << setw(14) << "Seconds" << setw(14) << "Peak size" << endl ;
+
+      const int QUEUES = 4 ;
+      const char * names[QUEUES] = { "Heap (lazy)", "IndexedHeap", "RadixHeap", "BucketQueue" };
+      int peak[QUEUES] = { 0 };
+      double seconds[QUEUES] = { 0 };
+      for( int r = 0 ; r < runs ; r++ ){
+         int source = (r * 7919) % n ;
+         vector<int> dist[QUEUES] ;
+         for( int q = 0 ; q < QUEUES ; q++ ){
+            auto start = chrono::high_resolution_clock::now();
+            if( q == 0 ) dist[q] = dijkstraLazy( G, source, Heap(n), peak[q] );
+            else if( q == 1 ) dist[q] = dijkstraIndexed( G, source, peak[q] );
+            else if( q == 2 ) dist[q] = dijkstraLazy( G, source, RadixHeap(), peak[q] );
+            else dist[q] = dijkstraLazy( G, source, BucketQueue(1001), peak[q] ); // weights are at most 1000
+            seconds[q] += chrono::duration<double>( chrono::high_resolution_clock::now() - start ).count();
+            if( dist[q] != dist[0] ){ cout << names[q] << " distances differ from source " << source << endl ; return 1 ; }
+         }
+      }
+
+      for( int q = 0 ; q < QUEUES ; q++ ){
+         cout << left << setw(18) << names[q] << setw(14) << seconds[q] / runs << setw(14) << peak[q] << endl ;
+      }
+      return 0 ;
+}
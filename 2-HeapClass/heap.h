@@ -4,8 +4,17 @@
   Stores pairs <element,priority> of ints.
   Supports O(log n) insertion, O(1) peeking at min priority and element 
   with min priority, and O(log n) extraction of element with min priority.
+  Capacity doubles when the Heap is full, so insertion is amortized O(log n)
+  and never fails unless memory runs out.
+  For merge and ranking loops, replaceTop and pushPop do an extractMin plus
+  an insert with one trickleDown, extractMinBatch pops k pairs, and
+  peekTopK reads the k smallest in O(k log k) without changing the Heap.
 *******************************************************/
+#pragma once
 #include <iostream>
+#include <new>
+#include <algorithm>
+#include <cassert>
 using namespace std;
 
 class Heap{
@@ -30,6 +39,15 @@ public:
    // Capacity of the new Heap is its size plus the "spare capacity" c.
    Heap( const Heap & Heap1, const Heap & Heap2, int c ); 
 
+   // Copy constructor and assignment, deep copy with the same capacity.
+   Heap( const Heap & other );
+   Heap & operator=( const Heap & other );
+
+   // Move constructor and assignment, O(1). Take the array of the argument,
+   // which is left empty with capacity 0.
+   Heap( Heap && other ) noexcept;
+   Heap & operator=( Heap && other ) noexcept;
+
    // Destructor.
    ~Heap(); 
 
@@ -37,12 +55,36 @@ public:
    bool empty() const {return hSize == 0;}; // True iff Heap is empty.
    int size() const { return hSize ;} ; // Current size of Heap.
    int capacity() const { return hCapacity ;} ; // Current capacity.
-   int peekMin() const { return A[0].element ;} // Peek at minimum priority element.
-   int peekMinPriority() const { return A[0].priority ;} // Peek at minimum priority.
+   // Peek at minimum priority element. Requires: !empty(), a moved-from Heap has no array.
+   int peekMin() const { assert( !empty() ); return A[0].element ;}
+   // Peek at minimum priority. Requires: !empty().
+   int peekMinPriority() const { assert( !empty() ); return A[0].priority ;}
 
    // Modifiers
-   void insert( int element, int priority ); // Insert the pair <element,priority>.
-   int extractMin(); // Remove and return the highest (minimum) priority element.
+   // Modifiers that return bool return false, and leave the Heap unchanged,
+   // when they fail: growing ran out of memory or there was nothing to extract.
+   bool insert( int element, int priority ); // Insert the pair <element,priority>.
+   // Insert the pairs <elements[i],priorities[i]> for 0 <= i < n as one batch.
+   bool insertBatch( const int * elements, const int * priorities, int n );
+   // Remove the highest (minimum) priority element and store it in element.
+   bool extractMin( int & element );
+   // Remove and return the highest (minimum) priority element.
+   // Requires: !empty(). Returns 0 and changes nothing when empty.
+   int extractMin();
+   // Replace the minimum priority pair with <element,priority>, one trickleDown.
+   // Returns false, and changes nothing, if empty.
+   bool replaceTop( int element, int priority );
+   // Insert <element,priority>, then remove and return the minimum priority element.
+   // Returns element at once if it would be the minimum, without changing the Heap.
+   int pushPop( int element, int priority );
+   // Remove the min(k,size()) minimum priority pairs, storing their elements, and their
+   // priorities if 'priorities' is not nullptr, in priority order. Returns how many.
+   int extractMinBatch( int k, int * elements, int * priorities = nullptr );
+   // Like extractMinBatch, but leaves the Heap unchanged.
+   int peekTopK( int k, int * elements, int * priorities = nullptr ) const;
+
+   bool reserve( int c ); // Make capacity at least c.
+   bool shrink_to_fit(); // Make capacity equal to size.
 
    void printPQ() { // added for testing
 	   for (int i = 0; i < hSize; i++) { std::cout << A[i].element << ':' << A[i].priority << ' '; }
@@ -70,11 +112,17 @@ private:
    //   but the subtrees of its children are heaps.
    void trickleDown(int i);
 
+   // Fills the hole at the root with the last pair after the root was taken.
+   void refillRoot();
+
    // Establishes ordering invariant for entire array contents.
    void heapify(); //(Same as "make_heap" in lectures.)
 
    // Useful for implementing trickle up and down
    void swap(int i,int j);
+
+   // Moves contents to a new array of capacity c >= hSize.
+   bool resize(int c);
 };
 
 // default constructor
@@ -91,10 +139,12 @@ Heap::Heap(int c) // New empty Heap with capacity c.
 
 // New Heap construcor with capacity c+s, with s elements, consisting of pairs <Pi,Vi> where 
 //  Pi is Priorities[i], Ei is value Elements[i], for 0 <= i < s.
+// Copies the pairs in as they are and calls heapify() once, O(s) instead of O(s log s) for s inserts.
 Heap::Heap( const int * Priorities, const int * Elements, int s, int c) 
-	: hSize{ 0 }, hCapacity{ s + c }, A{ new Pair[s + c] }
+	: hSize{ s }, hCapacity{ s + c }, A{ new Pair[s + c] }
 {
-	for (int i{ 0 }; i < s; i++) { insert(Elements[i], Priorities[i]); }
+	for (int i{ 0 }; i < s; i++) { A[i] = Pair{ Elements[i], Priorities[i] }; }
+	heapify();
 }
 
 // New Heap constructor with combined contents and of the two given heaps.
@@ -106,6 +156,52 @@ Heap::Heap( const Heap & Heap1, const Heap & Heap2, int c )
 	heapify();
 }
 
+// Copy constructor, deep copies the array of 'other'
+Heap::Heap(const Heap& other)
+	: hSize{ other.hSize }, hCapacity{ other.hCapacity }, A{ new Pair[other.hCapacity] }
+{
+	for (int i{ 0 }; i < hSize; i++) { A[i] = other.A[i]; }
+}
+
+// Copy assignment, copies into a new array first so a failed allocation leaves this heap as it was
+Heap& Heap::operator=(const Heap& other)
+{
+	if (this == &other) { return *this; }
+
+	Pair* copy = new Pair[other.hCapacity];
+	for (int i{ 0 }; i < other.hSize; i++) { copy[i] = other.A[i]; }
+
+	delete[] A;
+	A = copy;
+	hSize = other.hSize;
+	hCapacity = other.hCapacity;
+	return *this;
+}
+
+// Move constructor, takes the array of 'other' without copying it
+Heap::Heap(Heap&& other) noexcept
+	: hSize{ other.hSize }, hCapacity{ other.hCapacity }, A{ other.A }
+{
+	other.A = nullptr;
+	other.hSize = 0;
+	other.hCapacity = 0;
+}
+
+// Move assignment, frees this heap's array and takes the array of 'other'
+Heap& Heap::operator=(Heap&& other) noexcept
+{
+	if (this == &other) { return *this; }
+
+	delete[] A;
+	A = other.A;
+	hSize = other.hSize;
+	hCapacity = other.hCapacity;
+	other.A = nullptr;
+	other.hSize = 0;
+	other.hCapacity = 0;
+	return *this;
+}
+
 // Destructor
 Heap::~Heap()
 {
@@ -115,15 +211,76 @@ Heap::~Heap()
 // Modifiers
 
 // inserts element/value at end and bubbles it up if needed to maintain priority queue (heap) properties
-// PRE: there is space left in the heap, hSize < hCapacity
-// POST: new Pair bubbled up according to priority
-void Heap::insert(int element, int priority)
+// doubles the capacity first if the heap is full
+// PRE: n/a
+// POST: new Pair bubbled up according to priority, returns false if the heap was full and could not grow
+bool Heap::insert(int element, int priority)
 {
-	if (hSize >= hCapacity) { exit(1); } // exit if full, not implementing resizing
+	if (hSize >= hCapacity && !resize(max(2 * hCapacity, DFLT_ARRAY_SIZE))) { return false; }
 	A[hSize].element = element;
 	A[hSize].priority = priority;
 	trickleUp(hSize);
 	hSize++;
+	return true;
+}
+
+// Moves the heap contents into a new array of capacity c, the order of the pairs does not change
+// PRE: c >= hSize
+// POST: hCapacity == c, returns false and keeps the old array if the new one could not be allocated
+bool Heap::resize(int c)
+{
+	Pair* bigger = nullptr;
+	if (c > 0) {
+		bigger = new (nothrow) Pair[c];
+		if (bigger == nullptr) { return false; }
+	}
+
+	for (int i{ 0 }; i < hSize; i++) { bigger[i] = A[i]; }
+	delete[] A;
+	A = bigger;
+	hCapacity = c;
+	return true;
+}
+
+// Grows the capacity to at least c so that many pairs can be inserted without reallocating
+// PRE: n/a
+// POST: hCapacity >= c, returns false if the array could not grow
+bool Heap::reserve(int c)
+{
+	return (c <= hCapacity) ? true : resize(c);
+}
+
+// Shrinks the capacity down to the current size, releasing the spare space
+// PRE: n/a
+// POST: hCapacity == hSize, returns false if the smaller array could not be allocated
+bool Heap::shrink_to_fit()
+{
+	return (hCapacity == hSize) ? true : resize(hSize);
+}
+
+// Appends all n pairs, then repairs the heap the cheaper way for the batch size. Trickling each new pair up
+// costs up to n * log(size) swaps, heapify() costs up to 2 * size no matter how many pairs were added, so a
+// small batch into a big heap is trickled up and a batch that is large relative to the heap is heapified.
+// Grows once to fit the whole batch, at least doubling like insert().
+// PRE: n/a
+// POST: all n pairs are in the heap and the ordering invariant holds, returns false and changes nothing if
+//  the heap could not grow
+bool Heap::insertBatch(const int* elements, const int* priorities, int n)
+{
+	if (n <= 0) { return true; }
+	if (hSize + n > hCapacity && !resize(max(hSize + n, 2 * hCapacity))) { return false; }
+
+	int first{ hSize };
+	for (int i{ 0 }; i < n; i++, hSize++) { A[hSize] = Pair{ elements[i], priorities[i] }; }
+
+	int levels{ 0 };
+	for (int t{ hSize }; t > 0; t >>= 1) { levels++; }
+
+	if (static_cast<long long>(n) * levels > 2LL * hSize) { heapify(); }
+	else {
+		for (int i{ first }; i < hSize; i++) { trickleUp(i); }
+	}
+	return true;
 }
 
 // Repairs the heap ordering invariant after adding a new element.
@@ -148,23 +305,120 @@ void Heap::swap(int i, int j)
    A[j] = temp ;
 }
 
-// Removes and returns the element with highest priority.
+// Removes the element with highest priority and stores it in 'element'.
 // (That is, the element associated with the minimum priority value.)
-// PRE: there is at least 1 Pair to extract element from
-// POST: returns the element with the highest priority and removes that Pair, while maintaining priority queue properties
-int Heap::extractMin()
+// PRE: n/a
+// POST: removes the Pair with the highest priority while maintaining priority queue properties, returns false
+//  and leaves 'element' alone if the heap is empty
+bool Heap::extractMin(int& element)
 {
-	if (hSize <= 0) { exit(1); }
+	if (hSize <= 0) { return false; }
 
-	int retVal{ A[0].element };
+	element = A[0].element;
 	swap(hSize - 1, 0);
 	hSize--;
 
 	if (hSize) { trickleDown(0); }
 
+	return true;
+}
+
+// Removes and returns the element with highest priority.
+// PRE: there is at least 1 Pair to extract element from
+// POST: returns the element with the highest priority and removes that Pair, returns 0 if the heap is empty
+int Heap::extractMin()
+{
+	int retVal{ 0 };
+	extractMin(retVal);
 	return retVal;
 }
 
+// Overwrites the root with the new pair and trickles it down, half the work of extractMin() then insert()
+// PRE: n/a
+// POST: the minimum pair is replaced by <element,priority>, returns false and changes nothing if the heap is empty
+bool Heap::replaceTop(int element, int priority)
+{
+	if (hSize <= 0) { return false; }
+
+	A[0] = Pair{ element, priority };
+	trickleDown(0);
+	return true;
+}
+
+// When the new pair is no larger than the minimum it would be extracted straight away, so it is handed back
+// without touching the heap, otherwise it replaces the root.
+// PRE: n/a
+// POST: returns the element of the minimum pair among the heap and <element,priority>, which is not in the heap
+int Heap::pushPop(int element, int priority)
+{
+	if (hSize <= 0 || priority <= A[0].priority) { return element; }
+
+	int top = A[0].element;
+	A[0] = Pair{ element, priority };
+	trickleDown(0);
+	return top;
+}
+
+// Moves the hole left at the root down along the smaller children to a leaf, then puts the last pair in it and
+// trickles that up. The last pair almost always belongs near the bottom, so this takes about log(size) + 1
+// comparisons where trickleDown(0) takes 2 * log(size), and it moves pairs instead of swapping them.
+// PRE: hSize >= 1 and A[0] has been taken
+// POST: the last pair has filled the hole, hSize is one less and the heap ordering invariant holds
+void Heap::refillRoot()
+{
+	hSize--;
+	if (hSize == 0) { return; }
+
+	Pair last = A[hSize];
+	int hole = 0;
+	for (int child = 1; child < hSize; child = 2 * hole + 1) {
+		if (child + 1 < hSize && A[child + 1].priority < A[child].priority) { child++; }
+		A[hole] = A[child];
+		hole = child;
+	}
+	while (hole > 0 && last.priority < A[(hole - 1) / 2].priority) {
+		A[hole] = A[(hole - 1) / 2];
+		hole = (hole - 1) / 2;
+	}
+	A[hole] = last;
+}
+
+// Pops pairs one after another like extractMin(), refilling the root with refillRoot().
+// PRE: 'elements', and 'priorities' if not nullptr, have room for min(k,size()) ints
+// POST: the min(k,size()) minimum pairs are removed and stored in priority order, returns how many were
+int Heap::extractMinBatch(int k, int* elements, int* priorities)
+{
+	int n = max(0, min(k, hSize));
+	for (int j{ 0 }; j < n; j++) {
+		elements[j] = A[0].element;
+		if (priorities != nullptr) { priorities[j] = A[0].priority; }
+		refillRoot();
+	}
+	return n;
+}
+
+// The k smallest pairs form a subtree at the root, so they are found by a best-first walk from the root. The
+// frontier is a second Heap holding <index,priority> of the pairs whose parent has been taken, and never has
+// more than k+1 pairs, so the walk costs O(k log k) however big this heap is.
+// PRE: 'elements', and 'priorities' if not nullptr, have room for min(k,size()) ints
+// POST: stores the min(k,size()) minimum pairs in priority order, returns how many, the heap is unchanged
+int Heap::peekTopK(int k, int* elements, int* priorities) const
+{
+	int n = max(0, min(k, hSize));
+	if (n == 0) { return 0; }
+
+	Heap frontier(n + 1);
+	frontier.insert(0, A[0].priority);
+	for (int j{ 0 }; j < n; j++) {
+		int i = frontier.extractMin();
+		elements[j] = A[i].element;
+		if (priorities != nullptr) { priorities[j] = A[i].priority; }
+		if (2 * i + 1 < hSize) { frontier.insert(2 * i + 1, A[2 * i + 1].priority); }
+		if (2 * i + 2 < hSize) { frontier.insert(2 * i + 2, A[2 * i + 2].priority); }
+	}
+	return n;
+}
+
 // Repairs the heap ordering invariant after replacing the root.
 // (extractMin() calls trickleDown(0)).
 // (trickleDown(i) performs the repair on the subtree rooted a A[i].)
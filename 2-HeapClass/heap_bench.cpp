@@ -0,0 +1,179 @@
+/*************************************************************
+   Throughput benchmark for Heap, written as CSV to stdout:
+     workload,order,n,ops,seconds,ns_per_op,mops_per_s
+   Workloads, for n = 1K, 10K .. max n:
+     insert     n inserts into an empty Heap
+     extract    n extractMins from a Heap of n pairs
+     hold       n rounds of extractMin then insert at the extracted
+                priority plus a random increment, on n pairs
+     dijkstra   shortest paths with duplicate pushes on a sqrt(n)
+                by sqrt(n) grid with random weights 1 .. 100
+     events     discrete event simulation with n pending events,
+                each event schedules the next one of its source, a
+                short delay 9 times in 10 and a long timeout otherwise
+   insert and extract run with sorted, reverse and random priorities.
+   Small sizes are repeated until at least 10M operations were timed.
+   Usage: heap_bench [max n] [min n]
+**************************************************************/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include "heap.h"
+using namespace std;
+
+const long long MIN_OPS = 10000000 ;
+
+long long sink ; // sum of extracted elements, so the extractions cannot be optimized away
+
+// Priorities 0 .. n-1 in the given order.
+vector<int> makeOrder( const char * order, int n ){
+      vector<int> P(n);
+      for( int i = 0 ; i < n ; i++ ) P[i] = i ;
+      if( order[0] == 'r' && order[1] == 'e' ) reverse( P.begin(), P.end() );
+      else if( order[0] == 'r' ) shuffle( P.begin(), P.end(), mt19937(42) );
+      return P ;
+}
+
+// A Heap of n pairs with random priorities, built by heapify.
+Heap makeHeap( int n, mt19937 & gen ){
+      vector<int> P(n), E(n) ;
+      for( int i = 0 ; i < n ; i++ ){ P[i] = (int)(gen() >> 2) ; E[i] = i ; }
+      return Heap( P.data(), E.data(), n, 1 );
+}
+
+void report( const char * workload, const char * order, int n, long long ops, double seconds ){
+      cout << workload << ',' << order << ',' << n << ',' << ops << ',' << seconds << ','
+           << seconds * 1e9 / ops << ',' << ops / seconds / 1e6 << endl ;
+}
+
+double since( chrono::high_resolution_clock::time_point start ){
+      return chrono::duration<double>( chrono::high_resolution_clock::now() - start ).count();
+}
+
+void benchInsert( const char * order, int n ){
+      vector<int> P = makeOrder( order, n );
+      long long ops = 0 ;
+      double seconds = 0 ;
+      while( ops < MIN_OPS ){
+         auto start = chrono::high_resolution_clock::now();
+         Heap H ;
+         for( int i = 0 ; i < n ; i++ ) H.insert( i, P[i] );
+         seconds += since(start);
+         ops += n ;
+      }
+      report( "insert", order, n, ops, seconds );
+}
+
+void benchExtract( const char * order, int n ){
+      vector<int> P = makeOrder( order, n ), E(n) ;
+      for( int i = 0 ; i < n ; i++ ) E[i] = i ;
+      long long ops = 0 ;
+      double seconds = 0 ;
+      while( ops < MIN_OPS ){
+         Heap H( P.data(), E.data(), n, 0 );
+         auto start = chrono::high_resolution_clock::now();
+         for( int i = 0 ; i < n ; i++ ) sink += H.extractMin();
+         seconds += since(start);
+         ops += n ;
+      }
+      report( "extract", order, n, ops, seconds );
+}
+
+void benchHold( int n ){
+      mt19937 gen(42);
+      long long ops = 0 ;
+      double seconds = 0 ;
+      while( ops < MIN_OPS ){
+         Heap H = makeHeap( n, gen );
+         auto start = chrono::high_resolution_clock::now();
+         for( int i = 0 ; i < n ; i++ ){
+            int p = H.peekMinPriority();
+            int e = H.extractMin();
+            H.insert( e, p + (int)(gen() % 1024) );
+         }
+         seconds += since(start);
+         ops += 2LL * n ;
+      }
+      report( "hold", "random", n, ops, seconds );
+}
+
+// Lazy-deletion Dijkstra from a corner of a side by side grid, 4-neighbour edges.
+void benchDijkstra( int n ){
+      int side = max( 2, (int)sqrt( (double)n ) );
+      int V = side * side ;
+      mt19937 gen(42);
+      vector<unsigned char> weight( 4LL * V );
+      for( unsigned char & w : weight ) w = (unsigned char)(1 + gen() % 100);
+      const int dr[4] = { -1, 1, 0, 0 }, dc[4] = { 0, 0, -1, 1 };
+
+      long long ops = 0 ;
+      double seconds = 0 ;
+      while( ops < MIN_OPS ){
+         vector<int> dist( V, INT_MAX );
+         vector<bool> done( V, false );
+         auto start = chrono::high_resolution_clock::now();
+         Heap H ;
+         dist[0] = 0 ;
+         H.insert( 0, 0 );
+         ops++ ;
+         int v ;
+         while( H.extractMin(v) ){
+            ops++ ;
+            if( done[v] ) continue ;
+            done[v] = true ;
+            int r = v / side, c = v % side ;
+            for( int d = 0 ; d < 4 ; d++ ){
+               int nr = r + dr[d], nc = c + dc[d] ;
+               if( nr < 0 || nr >= side || nc < 0 || nc >= side ) continue ;
+               int u = nr * side + nc ;
+               int nd = dist[v] + weight[4LL * v + d] ;
+               if( nd < dist[u] ){ dist[u] = nd ; H.insert( u, nd ); ops++ ; }
+            }
+         }
+         seconds += since(start);
+      }
+      report( "dijkstra", "grid", V, ops, seconds );
+}
+
+// n sources each with one pending event, run for n events per repetition.
+void benchEvents( int n ){
+      mt19937 gen(42);
+      long long ops = 0 ;
+      double seconds = 0 ;
+      while( ops < MIN_OPS ){
+         Heap H( n + 1 );
+         for( int s = 0 ; s < n ; s++ ) H.insert( s, (int)(gen() % 100) );
+         auto start = chrono::high_resolution_clock::now();
+         for( int i = 0 ; i < n ; i++ ){
+            int now = H.peekMinPriority();
+            int s = H.extractMin();
+            int delay = ( gen() % 10 != 0 ) ? 1 + (int)(gen() % 100) : 1000 + (int)(gen() % 100000) ;
+            H.insert( s, now + delay );
+         }
+         seconds += since(start);
+         ops += 2LL * n ;
+      }
+      report( "events", "timeouts", n, ops, seconds );
+}
+
+int main( int argc, char * argv[] ){
+      long long maxN = (argc > 1) ? atoll(argv[1]) : 10000000 ;
+      long long minN = (argc > 2) ? atoll(argv[2]) : 1000 ;
+      const char * orders[3] = { "sorted", "reverse", "random" };
+
+      cout << "workload,order,n,ops,seconds,ns_per_op,mops_per_s" << endl ;
+      for( long long n = minN ; n <= maxN && n <= INT_MAX / 2 ; n *= 10 ){
+         for( const char * order : orders ) benchInsert( order, (int)n );
+         for( const char * order : orders ) benchExtract( order, (int)n );
+         benchHold( (int)n );
+         benchDijkstra( (int)n );
+         benchEvents( (int)n );
+      }
+      cerr << "checksum " << sink << endl ;
+      return 0 ;
+}
@@ -0,0 +1,240 @@
+/******************************************************
+  IndexedHeap.h -- Declarations for Indexed Heap-of-Pair-of-Ints Class
+
+  Stores pairs <element,priority> of ints like Heap, but each element is a
+  handle that appears at most once, and a position map from handle to array
+  slot is kept up to date in swap(). That lets an entry be found and updated
+  in place instead of inserting a duplicate and skipping the stale one later.
+  Supports O(log n) insertion, extraction, decreaseKey, increaseKey and erase,
+  and O(1) contains and peeking at min priority and element with min priority.
+  Handles are small non-negative ints, e.g. vertex numbers; the position map
+  takes one int per handle up to the largest one used.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <vector>
+#include <cassert>
+using namespace std;
+
+class IndexedHeap{
+
+public:
+   // Constructors
+
+   // New empty IndexedHeap.
+   IndexedHeap();
+
+   // New empty IndexedHeap with room for handles 0 .. n-1 before the
+   // position map has to grow.
+   IndexedHeap(int n);
+
+   // Accessors
+   bool empty() const { return A.empty(); } // True iff IndexedHeap is empty.
+   int size() const { return static_cast<int>(A.size()); } // Current size of IndexedHeap.
+   int peekMin() const { assert( !empty() ); return A[0].element; } // Peek at minimum priority element. Requires: !empty().
+   int peekMinPriority() const { assert( !empty() ); return A[0].priority; } // Peek at minimum priority. Requires: !empty().
+   bool contains( int element ) const; // True iff element is in the IndexedHeap.
+   int priorityOf( int element ) const; // Priority of element. Requires: contains(element).
+
+   // Modifiers
+   // All return false, and leave the IndexedHeap unchanged, when the request
+   // does not apply: element already there (insert), element not there, new
+   // priority on the wrong side of the current one, or nothing to extract.
+   bool insert( int element, int priority ); // Insert the pair <element,priority>. Requires: element >= 0.
+   bool decreaseKey( int element, int priority ); // Lower the priority of element.
+   bool increaseKey( int element, int priority ); // Raise the priority of element.
+   bool changePriority( int element, int priority ); // Set the priority of element either way.
+   bool erase( int element ); // Remove element, wherever it is.
+   bool extractMin( int & element ); // Remove the minimum priority element and store it in element.
+   void clear(); // Remove everything, keeping the memory.
+
+private:
+   class Pair{
+      public:
+        int element ;
+        int priority ;
+   };
+
+   vector<Pair> A ; // Heap contents.
+   vector<int> pos ; // pos[e] is the slot of element e in A, -1 if e is not in the IndexedHeap.
+
+   // Repairs ordering invariant after A[i] got a smaller priority.
+   void trickleUp(int i);
+
+   // Repairs ordering invariant after A[i] got a larger priority.
+   void trickleDown(int i);
+
+   // Swaps two slots and updates the position map for both elements.
+   void swap(int i,int j);
+
+   // Removes the pair at slot i.
+   void removeAt(int i);
+};
+
+// default constructor
+IndexedHeap::IndexedHeap()
+{
+}
+
+// constructor which sizes the position map for handles 0 .. n-1
+IndexedHeap::IndexedHeap(int n)
+	: pos(n, -1)
+{
+	A.reserve(n);
+}
+
+// PRE: n/a
+// POST: returns true if 'element' is a handle currently in the heap
+bool IndexedHeap::contains(int element) const
+{
+	return element >= 0 && element < static_cast<int>(pos.size()) && pos[element] >= 0;
+}
+
+// PRE: contains(element)
+// POST: returns the priority currently stored for 'element'
+int IndexedHeap::priorityOf(int element) const
+{
+	return A[pos[element]].priority;
+}
+
+// inserts element/value at end and bubbles it up, growing the position map if 'element' is a new largest handle
+// PRE: n/a
+// POST: new Pair bubbled up according to priority, returns false if 'element' is negative or already in the heap
+bool IndexedHeap::insert(int element, int priority)
+{
+	if (element < 0 || contains(element)) { return false; }
+	if (element >= static_cast<int>(pos.size())) { pos.resize(max(element + 1, 2 * static_cast<int>(pos.size())), -1); }
+
+	pos[element] = static_cast<int>(A.size());
+	A.push_back(Pair{ element, priority });
+	trickleUp(pos[element]);
+	return true;
+}
+
+// Lowers the priority of 'element' and bubbles it up, the decrease-key step of Dijkstra and Prim
+// PRE: n/a
+// POST: returns false if 'element' is not in the heap or 'priority' is larger than its current one
+bool IndexedHeap::decreaseKey(int element, int priority)
+{
+	if (!contains(element) || priority > A[pos[element]].priority) { return false; }
+
+	A[pos[element]].priority = priority;
+	trickleUp(pos[element]);
+	return true;
+}
+
+// Raises the priority of 'element' and trickles it down
+// PRE: n/a
+// POST: returns false if 'element' is not in the heap or 'priority' is smaller than its current one
+bool IndexedHeap::increaseKey(int element, int priority)
+{
+	if (!contains(element) || priority < A[pos[element]].priority) { return false; }
+
+	A[pos[element]].priority = priority;
+	trickleDown(pos[element]);
+	return true;
+}
+
+// Sets the priority of 'element' to 'priority', in whichever direction that is
+// PRE: n/a
+// POST: returns false if 'element' is not in the heap
+bool IndexedHeap::changePriority(int element, int priority)
+{
+	if (!contains(element)) { return false; }
+	return (priority < A[pos[element]].priority) ? decreaseKey(element, priority) : increaseKey(element, priority);
+}
+
+// Removes 'element' from wherever it is in the heap
+// PRE: n/a
+// POST: returns false if 'element' is not in the heap
+bool IndexedHeap::erase(int element)
+{
+	if (!contains(element)) { return false; }
+	removeAt(pos[element]);
+	return true;
+}
+
+// Removes the element with highest priority and stores it in 'element'.
+// (That is, the element associated with the minimum priority value.)
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if the heap is empty
+bool IndexedHeap::extractMin(int& element)
+{
+	if (A.empty()) { return false; }
+
+	element = A[0].element;
+	removeAt(0);
+	return true;
+}
+
+// Empties the heap, only the handles in it are reset so this is O(size) not O(largest handle)
+// PRE: n/a
+// POST: heap is empty, memory is kept for reuse
+void IndexedHeap::clear()
+{
+	for (const Pair& p : A) { pos[p.element] = -1; }
+	A.clear();
+}
+
+// Moves the last pair into slot i and repairs the ordering in whichever direction it broke
+// PRE: 0 <= i < size()
+// POST: the pair that was at slot i is gone and its handle unmapped
+void IndexedHeap::removeAt(int i)
+{
+	int last = static_cast<int>(A.size()) - 1;
+	int removed = A[i].element;
+
+	swap(i, last);
+	A.pop_back();
+	pos[removed] = -1;
+
+	if (i < last) { // the pair moved into slot i can be smaller than its new parent or larger than its new children
+		int moved = A[i].element;
+		trickleUp(i);
+		if (pos[moved] == i) { trickleDown(i); }
+	}
+}
+
+// Repairs the heap ordering invariant after the pair at A[i] got smaller, same comparisons as Heap's recursive version written
+// as a loop, with swap() keeping pos in step
+// PRE: index i is valid
+// POST: pair bubbled up according to priority
+void IndexedHeap::trickleUp(int i)
+{
+	while (i > 0) {
+		int pInd{ (i - 1) / 2 };
+		if (A[i].priority >= A[pInd].priority) { return; }
+		swap(i, pInd);
+		i = pInd;
+	}
+}
+
+// Repairs the heap ordering invariant for the subtree rooted at A[i] after the pair there got larger
+// PRE: index i is valid
+// POST: subtree is in heap form
+void IndexedHeap::trickleDown(int i)
+{
+	int n = static_cast<int>(A.size());
+	while (true) {
+		int smallest = i;
+		int l = i * 2 + 1;
+		int r = i * 2 + 2;
+
+		if (l < n && A[l].priority < A[smallest].priority) { smallest = l; }
+		if (r < n && A[r].priority < A[smallest].priority) { smallest = r; }
+		if (smallest == i) { return; }
+
+		swap(i, smallest);
+		i = smallest;
+	}
+}
+
+// Swaps the pairs in slots i and j, and points both handles at their new slots
+void IndexedHeap::swap(int i, int j)
+{
+	Pair temp = A[i];
+	A[i] = A[j];
+	A[j] = temp;
+	pos[A[i].element] = i;
+	pos[A[j].element] = j;
+}
@@ -0,0 +1,217 @@
+/******************************************************
+  LoserTree.h -- Declarations for a Tournament Tree K-Way Merger
+
+  Merges k sorted sequences of ints into one sorted sequence. The inputs
+  are the leaves of a complete binary tournament; each inner node keeps the
+  loser of the match played there and the overall winner sits on top. After
+  the winner is output, only the matches on the path from its leaf to the
+  root are replayed, against the stored losers: exactly log k comparisons
+  per element, where a Heap needs up to 2 log k. Each node stores its
+  loser's value and input packed in one 64-bit word, so a match is one
+  integer comparison in a small array that stays in cache.
+  Inputs are in-memory ranges, or MergeSources that hand over one block at
+  a time, like FileSource for runs stored in binary files. Equal values
+  come out in the order their inputs were added.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+// Sorted input delivered in blocks.
+class MergeSource{
+
+public:
+   virtual ~MergeSource() {}
+
+   // Points [begin,end) at the next non-empty block of the sorted input, which stays
+   // valid until the next call. Returns false when the input is used up.
+   virtual bool refill( const int * & begin, const int * & end ) = 0;
+};
+
+// Sorted binary file of native ints, read through a buffer of 'bufferInts' ints.
+class FileSource : public MergeSource{
+
+public:
+   FileSource( const char * path, int bufferInts = 1 << 16 )
+      : file{ fopen( path, "rb" ) }, buffer( bufferInts > 0 ? bufferInts : 1 ) {}
+   ~FileSource() { if( file != nullptr ) fclose( file ); }
+
+   FileSource( const FileSource & ) = delete;
+   FileSource & operator=( const FileSource & ) = delete;
+
+   bool isOpen() const { return file != nullptr; } // False if the file could not be opened.
+
+   bool refill( const int * & begin, const int * & end ) override {
+      if( file == nullptr ) return false ;
+      size_t n = fread( buffer.data(), sizeof(int), buffer.size(), file );
+      if( n == 0 ) return false ;
+      begin = buffer.data();
+      end = buffer.data() + n ;
+      return true ;
+   }
+
+private:
+   FILE * file ;
+   vector<int> buffer ;
+};
+
+class LoserTree{
+
+public:
+   // New merger with no inputs.
+   LoserTree();
+
+   // Add an input, before the first call to next(). Ranges are not copied and
+   // sources are not owned, both must outlive the merge.
+   void addRange( const int * begin, const int * end );
+   void addSource( MergeSource * source );
+
+   // Accessors
+   int inputs() const { return k; } // Number of inputs added.
+
+   // Store the next value of the merged sequence in 'value', and the index of the input
+   // it came from, in the order inputs were added, in 'input'. Returns false when all
+   // inputs are used up.
+   bool next( int & value );
+   bool next( int & value, int & input );
+   // Store up to n next values in 'out'. Returns how many were stored, less than n only at the end.
+   long long merge( int * out, long long n );
+
+private:
+   int k ; // number of inputs
+   int leaves ; // k rounded up to a power of 2, the unused leaves are empty inputs
+   bool built ;
+   vector<const int*> cur ; // next value of each leaf, cur[i] == last[i] when it is used up
+   vector<const int*> last ;
+   vector<MergeSource*> sources ; // nullptr for ranges
+   vector<unsigned long long> tree ; // tree[1 .. leaves-1] are the losers, tree[0] the winner, as codes
+
+   // A leaf's next value and index packed so that codes order like (value, leaf): the value with its sign
+   // bit flipped in the high half, the leaf in the low half. A used up leaf gets value INT_MAX and index
+   // leaf + leaves, which comes after every real value, INT_MAX included.
+   unsigned long long code( int leaf ) const {
+      if( cur[leaf] == last[leaf] ) return (0xFFFFFFFFull << 32) | static_cast<unsigned>(leaf + leaves) ;
+      return (static_cast<unsigned long long>(static_cast<unsigned>(*cur[leaf]) ^ 0x80000000u) << 32) | static_cast<unsigned>(leaf) ;
+   }
+   static int valueOf( unsigned long long c ) { return static_cast<int>(static_cast<unsigned>(c >> 32) ^ 0x80000000u); }
+   int leafOf( unsigned long long c ) const { return static_cast<int>(c) & (leaves - 1); }
+   bool usedUp( unsigned long long c ) const { return static_cast<unsigned>(c) >= static_cast<unsigned>(leaves); }
+
+   // Plays the initial tournament.
+   void build();
+
+   // Moves the winner past its value and replays the path from its leaf to the root.
+   void advance();
+};
+
+// default constructor
+LoserTree::LoserTree()
+	: k{ 0 }, leaves{ 1 }, built{ false }
+{
+}
+
+// PRE: next() has not been called yet
+// POST: [begin,end) is the next input
+void LoserTree::addRange(const int* begin, const int* end)
+{
+	cur.push_back(begin);
+	last.push_back(end);
+	sources.push_back(nullptr);
+	k++;
+}
+
+// PRE: next() has not been called yet
+// POST: 'source' is the next input, its first block is read
+void LoserTree::addSource(MergeSource* source)
+{
+	const int* begin = nullptr;
+	const int* end = nullptr;
+	if (!source->refill(begin, end)) { begin = end = nullptr; }
+	cur.push_back(begin);
+	last.push_back(end);
+	sources.push_back(source);
+	k++;
+}
+
+// Pads the inputs to a power of 2 with empty ones, then plays every match bottom up: winners[] holds the winner
+// of each subtree, the loser of each match is stored in its node.
+// PRE: n/a
+// POST: tree[0] is the code of the leaf with the smallest next value, each inner node holds the loser of its match
+void LoserTree::build()
+{
+	while (leaves < k) { leaves *= 2; }
+	cur.resize(leaves, nullptr);
+	last.resize(leaves, nullptr);
+	sources.resize(leaves, nullptr);
+	tree.assign(leaves, 0);
+
+	vector<unsigned long long> winners(2 * leaves);
+	for (int i{ 0 }; i < leaves; i++) { winners[leaves + i] = code(i); }
+	for (int node{ leaves - 1 }; node >= 1; node--) {
+		winners[node] = min(winners[2 * node], winners[2 * node + 1]);
+		tree[node] = max(winners[2 * node], winners[2 * node + 1]);
+	}
+	tree[0] = winners[1];
+	built = true;
+}
+
+// Takes the winner's value, refilling its block from its source when it runs out, and then climbs from its leaf
+// to the root: at each node the climbing leaf plays the stored loser, and the loser of that match stays behind.
+// PRE: the tree is built and the winner is not used up
+// POST: tree[0] is the code of the leaf with the smallest next value again
+void LoserTree::advance()
+{
+	int leaf = leafOf(tree[0]);
+	if (++cur[leaf] == last[leaf] && sources[leaf] != nullptr && !sources[leaf]->refill(cur[leaf], last[leaf])) {
+		cur[leaf] = last[leaf] = nullptr;
+	}
+
+	// The swap is done with a mask instead of a branch: which side wins is a coin flip for random inputs, so a
+	// branch would be mispredicted about half the time
+	unsigned long long w = code(leaf);
+	for (int node{ (leaf + leaves) / 2 }; node >= 1; node /= 2) {
+		unsigned long long t = tree[node];
+		unsigned long long swap = (t ^ w) & (0 - static_cast<unsigned long long>(t < w));
+		tree[node] = t ^ swap;
+		w ^= swap;
+	}
+	tree[0] = w;
+}
+
+// PRE: n/a
+// POST: stores the next merged value, returns false and leaves 'value' alone when every input is used up
+bool LoserTree::next(int& value)
+{
+	int input;
+	return next(value, input);
+}
+
+// PRE: n/a
+// POST: stores the next merged value and its input, returns false and changes nothing when every input is used up
+bool LoserTree::next(int& value, int& input)
+{
+	if (!built) { build(); }
+	if (usedUp(tree[0])) { return false; }
+
+	value = valueOf(tree[0]);
+	input = leafOf(tree[0]);
+	advance();
+	return true;
+}
+
+// PRE: 'out' has room for n ints
+// POST: stores the next min(n, values left) merged values, returns how many
+long long LoserTree::merge(int* out, long long n)
+{
+	if (!built) { build(); }
+
+	long long done{ 0 };
+	while (done < n && !usedUp(tree[0])) {
+		out[done++] = valueOf(tree[0]);
+		advance();
+	}
+	return done;
+}
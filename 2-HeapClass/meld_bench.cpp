@@ -0,0 +1,72 @@
+/*************************************************************
+   Meld-heavy benchmark, Heap's merging constructor against
+   PairingHeap::meld. Each round every worker queue gets a batch
+   of inserts, all of them are merged into the global queue, and
+   half of what arrived is extracted again.
+   Usage: meld_bench [workers] [batch] [rounds]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "heap.h"
+#include "pairingheap.h"
+using namespace std;
+
+const int G_WIDTH = 16 ;
+
+int main( int argc, char * argv[] ){
+      int workers = (argc > 1) ? atoi(argv[1]) : 16 ;
+      int batch = (argc > 2) ? atoi(argv[2]) : 1000 ;
+      int rounds = (argc > 3) ? atoi(argv[3]) : 100 ;
+
+      mt19937 gen(37);
+      vector<int> pri( (size_t)workers * batch * rounds );
+      for( size_t i = 0 ; i < pri.size() ; i++ ) pri[i] = (int)(gen() >> 1);
+
+      long long sumHeap = 0, sumPairing = 0 ; // extracted elements, both queues must agree
+      int finalHeap = 0, finalPairing = 0 ;
+
+      // Heap, every merge copies the global queue and re-heapifies
+      auto start = chrono::high_resolution_clock::now();
+      {
+         Heap global ;
+         size_t next = 0 ;
+         for( int r = 0 ; r < rounds ; r++ ){
+            for( int w = 0 ; w < workers ; w++ ){
+               Heap worker(batch);
+               for( int i = 0 ; i < batch ; i++, next++ ) worker.insert( (int)next, pri[next] );
+               global = Heap( global, worker, 0 );
+            }
+            for( int i = 0 ; i < workers * batch / 2 ; i++ ) sumHeap += global.extractMin();
+         }
+         finalHeap = global.size() ;
+      }
+      auto mid = chrono::high_resolution_clock::now();
+
+      // PairingHeap, the workers share the global queue's pool so every meld is one link
+      {
+         shared_ptr<PairingPool> pool = make_shared<PairingPool>();
+         PairingHeap global(pool) ;
+         size_t next = 0 ;
+         for( int r = 0 ; r < rounds ; r++ ){
+            for( int w = 0 ; w < workers ; w++ ){
+               PairingHeap worker(pool);
+               for( int i = 0 ; i < batch ; i++, next++ ) worker.insert( (int)next, pri[next] );
+               global.meld( worker );
+            }
+            for( int i = 0 ; i < workers * batch / 2 ; i++ ) sumPairing += global.extractMin();
+         }
+         finalPairing = global.size() ;
+      }
+      auto end = chrono::high_resolution_clock::now();
+
+      cout << "workers: " << workers << ", batch: " << batch << ", rounds: " << rounds << ", seconds" << endl ;
+      cout << left << setw(G_WIDTH) << "Queue" << setw(G_WIDTH) << "total" << setw(G_WIDTH) << "final size" << endl ;
+      cout << left << setw(G_WIDTH) << "Heap" << setw(G_WIDTH) << chrono::duration<double>(mid - start).count() << setw(G_WIDTH) << finalHeap << endl ;
+      cout << left << setw(G_WIDTH) << "PairingHeap" << setw(G_WIDTH) << chrono::duration<double>(end - mid).count() << setw(G_WIDTH) << finalPairing << endl ;
+      if( sumHeap != sumPairing ) { cout << "queues disagree" << endl ; return 1 ; }
+      return 0 ;
+}
@@ -0,0 +1,79 @@
+/*************************************************************
+   K-way merge benchmark, LoserTree against a Heap of the run
+   heads, for k = 2, 4 .. 4096 sorted runs of random ints.
+   The Heap merge is timed both as extractMin then insert and
+   with replaceTop. Times are nanoseconds per merged element.
+   Usage: merge_bench [total elements] [max k]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <algorithm>
+#include "heap.h"
+#include "losertree.h"
+using namespace std;
+
+const int G_WIDTH = 20 ;
+
+// Heap holding <run,value> for the head of every run, popping and pushing each element.
+void heapMerge( const vector< vector<int> > & runs, int * out ){
+      vector<size_t> pos( runs.size(), 0 );
+      Heap H( (int)runs.size() );
+      for( size_t r = 0 ; r < runs.size() ; r++ ) if( !runs[r].empty() ) H.insert( (int)r, runs[r][0] );
+      int r ;
+      while( H.extractMin(r) ){
+         *out++ = runs[r][pos[r]++] ;
+         if( pos[r] < runs[r].size() ) H.insert( r, runs[r][pos[r]] );
+      }
+}
+
+// Same, but the next head of the winning run replaces the top with one trickleDown.
+void heapReplaceMerge( const vector< vector<int> > & runs, int * out ){
+      vector<size_t> pos( runs.size(), 0 );
+      Heap H( (int)runs.size() );
+      for( size_t r = 0 ; r < runs.size() ; r++ ) if( !runs[r].empty() ) H.insert( (int)r, runs[r][0] );
+      while( !H.empty() ){
+         int r = H.peekMin() ;
+         *out++ = runs[r][pos[r]++] ;
+         if( pos[r] < runs[r].size() ) H.replaceTop( r, runs[r][pos[r]] );
+         else H.extractMin();
+      }
+}
+
+void treeMerge( const vector< vector<int> > & runs, int * out ){
+      LoserTree T ;
+      for( const vector<int> & run : runs ) T.addRange( run.data(), run.data() + run.size() );
+      T.merge( out, 1LL << 62 );
+}
+
+int main( int argc, char * argv[] ){
+      int total = (argc > 1) ? atoi(argv[1]) : 1 << 24 ;
+      int maxK = (argc > 2) ? atoi(argv[2]) : 4096 ;
+
+      cout << "elements: " << total << ", ns per element" << endl ;
+      cout << left << setw(G_WIDTH/2) << "k" << setw(G_WIDTH) << "Heap extract+insert" << setw(G_WIDTH) << "Heap replaceTop" << setw(G_WIDTH) << "LoserTree" << endl ;
+
+      mt19937 gen(41);
+      vector<int> outHeap( total ), outTree( total );
+      for( int k = 2 ; k <= maxK ; k *= 2 ){
+         vector< vector<int> > runs( k );
+         for( int i = 0 ; i < total ; i++ ) runs[i % k].push_back( (int)(gen() >> 1) );
+         for( vector<int> & run : runs ) sort( run.begin(), run.end() );
+
+         double ns[3] ;
+         for( int m = 0 ; m < 3 ; m++ ){
+            auto start = chrono::high_resolution_clock::now();
+            if( m == 0 ) heapMerge( runs, outHeap.data() );
+            else if( m == 1 ) heapReplaceMerge( runs, outHeap.data() );
+            else treeMerge( runs, outTree.data() );
+            ns[m] = chrono::duration<double>( chrono::high_resolution_clock::now() - start ).count() * 1e9 / total ;
+         }
+         if( outHeap != outTree ){ cout << "merges differ for k = " << k << endl ; return 1 ; }
+
+         cout << left << setw(G_WIDTH/2) << k << setw(G_WIDTH) << ns[0] << setw(G_WIDTH) << ns[1] << setw(G_WIDTH) << ns[2] << endl ;
+      }
+      return 0 ;
+}
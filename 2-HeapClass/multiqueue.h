@@ -0,0 +1,168 @@
+/******************************************************
+  MultiQueue.h -- Declarations for a Concurrent Relaxed Priority Queue
+
+  Stores pairs <element,priority> of ints for many threads at once, after
+  Rihani, Sanders and Dementiev, "MultiQueues: Simple Relaxed Concurrent
+  Priority Queues" (SPAA 2015). There are c*p Heaps for p threads, each
+  behind its own lock: insert puts the pair in a random Heap, extractMin
+  looks at the tops of two random Heaps and takes from the better one.
+  Threads rarely meet on a lock, so throughput grows with the threads.
+  The price is that extractMin is relaxed: it returns a pair close to the
+  minimum, not always the minimum. With c = 2 the extracted pair is on
+  average among the smallest O(c*p) in the queue.
+  extractMin only returns false after finding every Heap empty, so it can
+  miss pairs inserted during that scan, and size() is exact only when no
+  other thread is changing the queue.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <climits>
+#include "heap.h"
+using namespace std;
+
+class MultiQueue{
+
+public:
+   // New empty MultiQueue of c*p Heaps, for use by p threads.
+   MultiQueue( int p, int c = 2 );
+
+   MultiQueue( const MultiQueue & ) = delete;
+   MultiQueue & operator=( const MultiQueue & ) = delete;
+
+   // Accessors
+   int size() const; // Number of pairs, exact only when no other thread is changing the queue.
+   bool empty() const { return size() == 0; } // True iff MultiQueue is empty, with the same caveat.
+   int queues() const { return nQueues; } // Number of internal Heaps.
+
+   // Modifiers, safe to call from any number of threads at once
+   // Insert the pair <element,priority>. Returns false if the Heap could not grow.
+   bool insert( int element, int priority );
+   // Remove a pair with a small priority and store its element, and priority, in the arguments.
+   // Returns false, and changes nothing, if every Heap was empty.
+   bool extractMin( int & element );
+   bool extractMin( int & element, int & priority );
+
+private:
+   // One Heap with its lock, on its own cache line so threads working on
+   // neighbouring Heaps do not invalidate each other's lines.
+   class alignas(64) Queue{
+      public:
+        mutex lock ;
+        Heap H ;
+        atomic<int> top{ INT_MAX } ; // priority at the top of H, INT_MAX when H is empty
+        atomic<int> count{ 0 } ; // size of H, readable without the lock
+   };
+
+   unique_ptr<Queue[]> Q ;
+   int nQueues ;
+
+   // Random index of a Heap, from a generator private to the calling thread.
+   int randomQueue() const;
+
+   // Takes the top of Q[i], which the caller has locked. Returns false if it is empty.
+   bool takeTop( int i, int & element, int & priority );
+};
+
+// constructor which makes c*p empty heaps, at least 1
+MultiQueue::MultiQueue(int p, int c)
+	: Q{}, nQueues{ max(1, p * c) }
+{
+	Q.reset(new Queue[nQueues]);
+}
+
+// PRE: n/a
+// POST: returns the sum of the heap sizes
+int MultiQueue::size() const
+{
+	int total{ 0 };
+	for (int i{ 0 }; i < nQueues; i++) { total += Q[i].count.load(memory_order_relaxed); }
+	return total;
+}
+
+// xorshift32, one state per thread, seeded from the thread id so the threads draw different sequences
+// PRE: n/a
+// POST: returns an index in 0 .. nQueues-1
+int MultiQueue::randomQueue() const
+{
+	thread_local unsigned state = static_cast<unsigned>(hash<thread::id>()(this_thread::get_id())) | 1u;
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return static_cast<int>(state % static_cast<unsigned>(nQueues));
+}
+
+// PRE: Q[i].lock is held by the caller
+// POST: removes the top pair of Q[i] and republishes its top and count, returns false if Q[i] is empty
+bool MultiQueue::takeTop(int i, int& element, int& priority)
+{
+	Queue& q = Q[i];
+	if (q.H.empty()) { return false; }
+
+	priority = q.H.peekMinPriority();
+	q.H.extractMin(element);
+	q.top.store(q.H.empty() ? INT_MAX : q.H.peekMinPriority(), memory_order_relaxed);
+	q.count.store(q.H.size(), memory_order_relaxed);
+	return true;
+}
+
+// Inserts into a random heap, trying another one whenever the lock is taken. After nQueues busy heaps in a row
+// it waits for the last one instead of spinning.
+// PRE: n/a
+// POST: the pair is in one of the heaps, returns false if that heap could not grow
+bool MultiQueue::insert(int element, int priority)
+{
+	for (int tries{ 0 }; ; tries++) {
+		int i = randomQueue();
+		unique_lock<mutex> guard(Q[i].lock, defer_lock);
+		if (tries < nQueues) {
+			if (!guard.try_lock()) { continue; }
+		}
+		else { guard.lock(); }
+
+		Queue& q = Q[i];
+		if (!q.H.insert(element, priority)) { return false; }
+		q.top.store(q.H.peekMinPriority(), memory_order_relaxed);
+		q.count.store(q.H.size(), memory_order_relaxed);
+		return true;
+	}
+}
+
+// Removes and stores an element with a small priority.
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if every heap was empty
+bool MultiQueue::extractMin(int& element)
+{
+	int priority;
+	return extractMin(element, priority);
+}
+
+// Compares the published tops of two random heaps without locking either, then locks the better one. The tops
+// can be stale by the time the lock is held, which only makes the choice a little worse. Once 2*nQueues
+// attempts found empty or busy heaps, every heap is locked in turn so that false is only returned for an empty
+// queue.
+// PRE: n/a
+// POST: removes a pair and stores its element and priority, returns false and changes nothing if every heap
+//  was empty
+bool MultiQueue::extractMin(int& element, int& priority)
+{
+	for (int tries{ 0 }; tries < 2 * nQueues; tries++) {
+		int i = randomQueue();
+		int j = randomQueue();
+		if (Q[j].top.load(memory_order_relaxed) < Q[i].top.load(memory_order_relaxed)) { i = j; }
+		if (Q[i].count.load(memory_order_relaxed) == 0) { continue; }
+
+		unique_lock<mutex> guard(Q[i].lock, try_to_lock);
+		if (guard.owns_lock() && takeTop(i, element, priority)) { return true; }
+	}
+
+	for (int i{ 0 }; i < nQueues; i++) {
+		lock_guard<mutex> guard(Q[i].lock);
+		if (takeTop(i, element, priority)) { return true; }
+	}
+	return false;
+}
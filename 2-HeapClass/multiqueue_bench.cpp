@@ -0,0 +1,114 @@
+/*************************************************************
+   Concurrent priority queue benchmark, MultiQueue against Heap
+   behind one global mutex. Measures throughput of alternating
+   insert/extractMin for 1, 2, 4 .. max threads, and the rank
+   error of MultiQueue's extractMin: how many smaller priorities
+   were still in the queue when a pair was extracted.
+   Usage: multiqueue_bench [max threads] [ops per thread] [prefill]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "multiqueue.h"
+using namespace std;
+
+const int G_WIDTH = 16 ;
+
+// Global lock baseline, the way the worker threads use Heap today
+class LockedHeap{
+   public:
+      LockedHeap( int ) {}
+      bool insert( int element, int priority ){
+         lock_guard<mutex> guard(m);
+         return H.insert( element, priority );
+      }
+      bool extractMin( int & element ){
+         lock_guard<mutex> guard(m);
+         return H.extractMin(element);
+      }
+   private:
+      Heap H ;
+      mutex m ;
+};
+
+// Prefills the queue, then runs 'threads' threads doing 'ops' operations each, alternating
+// insert and extractMin. Returns the throughput in millions of operations per second.
+template <class Q>
+double runHold( int threads, int ops, int prefill ){
+      Q queue( threads );
+      mt19937 fill(39);
+      for( int i = 0 ; i < prefill ; i++ ) queue.insert( i, (int)(fill() >> 1) );
+
+      vector<thread> workers ;
+      auto start = chrono::high_resolution_clock::now();
+      for( int t = 0 ; t < threads ; t++ ){
+         workers.emplace_back( [&queue, t, ops]{
+            mt19937 gen( t * 7919 + 1 );
+            int x ;
+            for( int i = 0 ; i < ops ; i += 2 ){
+               queue.insert( i, (int)(gen() >> 1) );
+               queue.extractMin(x);
+            }
+         } );
+      }
+      for( thread & w : workers ) w.join();
+      chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start ;
+      return (double)threads * ops / elapsed.count() / 1e6 ;
+}
+
+// Rank error of MultiQueue(p) on one thread: inserts the priorities 0 .. n-1 in random order,
+// extracts them all and counts, with a Fenwick tree, the smaller priorities still queued at
+// each extraction. This measures the two-choice rule itself, contention only adds to it.
+void rankError( int p, int n, double & mean, int & worst ){
+      vector<int> order(n);
+      for( int i = 0 ; i < n ; i++ ) order[i] = i ;
+      shuffle( order.begin(), order.end(), mt19937(p) );
+
+      MultiQueue M(p);
+      vector<int> tree( n + 1, 0 ); // Fenwick tree over priorities still queued
+      for( int i = 0 ; i < n ; i++ ){
+         M.insert( order[i], order[i] );
+         for( int k = order[i] + 1 ; k <= n ; k += k & -k ) tree[k]++ ;
+      }
+
+      long long total = 0 ;
+      worst = 0 ;
+      int e, pr ;
+      while( M.extractMin( e, pr ) ){
+         int smaller = 0 ;
+         for( int k = pr ; k > 0 ; k -= k & -k ) smaller += tree[k] ;
+         for( int k = pr + 1 ; k <= n ; k += k & -k ) tree[k]-- ;
+         total += smaller ;
+         if( smaller > worst ) worst = smaller ;
+      }
+      mean = (double)total / n ;
+}
+
+int main( int argc, char * argv[] ){
+      int maxThreads = (argc > 1) ? atoi(argv[1]) : (int)max( 1u, thread::hardware_concurrency() );
+      int ops = (argc > 2) ? atoi(argv[2]) : 1000000 ;
+      int prefill = (argc > 3) ? atoi(argv[3]) : 1000000 ;
+
+      cout << "prefill: " << prefill << ", ops/thread: " << ops << ", throughput in Mops/s" << endl ;
+      cout << left << setw(G_WIDTH) << "Threads" << setw(G_WIDTH) << "MultiQueue" << setw(G_WIDTH) << "Heap + mutex" << endl ;
+      for( int threads = 1 ; threads <= maxThreads ; threads *= 2 ){
+         cout << left << setw(G_WIDTH) << threads ;
+         cout << setw(G_WIDTH) << runHold<MultiQueue>( threads, ops, prefill ) ;
+         cout << setw(G_WIDTH) << runHold<LockedHeap>( threads, ops, prefill ) << endl ;
+      }
+
+      cout << endl << "rank error of extractMin over " << prefill << " pairs, c = 2" << endl ;
+      cout << left << setw(G_WIDTH) << "Threads (p)" << setw(G_WIDTH) << "Heaps" << setw(G_WIDTH) << "mean" << setw(G_WIDTH) << "max" << endl ;
+      for( int p = 1 ; p <= max( maxThreads, 64 ) ; p *= 4 ){
+         double mean ;
+         int worst ;
+         rankError( p, prefill, mean, worst );
+         cout << left << setw(G_WIDTH) << p << setw(G_WIDTH) << 2 * p << setw(G_WIDTH) << mean << setw(G_WIDTH) << worst << endl ;
+      }
+      return 0 ;
+}
@@ -0,0 +1,280 @@
+/******************************************************
+  PairingHeap.h -- Declarations for Pairing Heap-of-Pair-of-Ints Class
+
+  Stores pairs <element,priority> of ints like Heap, as a pairing heap:
+  a tree where every node comes before its children, each node keeping only
+  its first child and next sibling. Merging two heaps is a single link of
+  their roots, so meld and insert are O(1), and extractMin is amortized
+  O(log n) by linking the root's children in pairs, then right to left.
+  Nodes live in a PairingPool, a growable array with a free list, and are
+  named by index. Heaps that share one pool meld in O(1) without copying;
+  melding heaps from different pools copies the other heap's nodes over.
+  A pool is not thread safe, so heaps sharing one must be used by one
+  thread at a time.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cassert>
+using namespace std;
+
+// Node storage shared by any number of PairingHeaps.
+class PairingPool{
+
+public:
+   class Node{
+      public:
+        int element ;
+        int priority ;
+        int child ; // first child, -1 for none
+        int sibling ; // next sibling, -1 for none. Links the free list for free nodes.
+   };
+
+   PairingPool() : freeHead{ -1 } {}
+
+   // Index of a node holding <element,priority>, reusing a freed one if there is any.
+   int allocate( int element, int priority ){
+      int i = freeHead ;
+      if( i >= 0 ) freeHead = nodes[i].sibling ;
+      else { i = static_cast<int>(nodes.size()); nodes.push_back(Node()); }
+      nodes[i] = Node{ element, priority, -1, -1 };
+      return i ;
+   }
+
+   // Puts node i on the free list.
+   void release( int i ){
+      nodes[i].sibling = freeHead ;
+      freeHead = i ;
+   }
+
+   void reserve( int n ){ nodes.reserve(n); }
+
+private:
+   friend class PairingHeap;
+
+   vector<Node> nodes ;
+   int freeHead ; // first free node, -1 for none
+};
+
+class PairingHeap{
+
+public:
+   // Constructors and Destructor
+
+   // New empty PairingHeap with a pool of its own.
+   PairingHeap();
+
+   // New empty PairingHeap keeping its nodes in 'pool'. Heaps created with
+   // the same pool can be melded in O(1).
+   PairingHeap( const shared_ptr<PairingPool> & pool );
+
+   // Moves keep the pool, copies are not allowed.
+   PairingHeap( PairingHeap && other ) noexcept;
+   PairingHeap & operator=( PairingHeap && other ) noexcept;
+   PairingHeap( const PairingHeap & ) = delete;
+   PairingHeap & operator=( const PairingHeap & ) = delete;
+
+   // Destructor, returns the nodes to the pool.
+   ~PairingHeap();
+
+   // Accessors
+   bool empty() const { return hSize == 0; } // True iff PairingHeap is empty.
+   int size() const { return hSize; } // Current size of PairingHeap.
+   int peekMin() const { assert( !empty() ); return pool->nodes[root].element; } // Peek at minimum priority element. Requires: !empty().
+   int peekMinPriority() const { assert( !empty() ); return pool->nodes[root].priority; } // Peek at minimum priority. Requires: !empty().
+
+   // Modifiers
+   bool insert( int element, int priority ); // Insert the pair <element,priority>.
+   // Remove the highest (minimum) priority element and store it in element.
+   // Returns false, and changes nothing, if empty.
+   bool extractMin( int & element );
+   // Remove and return the highest (minimum) priority element.
+   // Requires: !empty(). Returns 0 and changes nothing when empty.
+   int extractMin();
+   // Move every pair of 'other' into this heap, leaving 'other' empty.
+   // O(1) when both heaps share a pool, O(other.size()) otherwise.
+   void meld( PairingHeap & other );
+   void clear(); // Remove everything.
+
+private:
+   shared_ptr<PairingPool> pool ;
+   int root ; // index of the root node, -1 when empty
+   int hSize ; // Current number of elements.
+
+   // Makes the root that comes later the first child of the other, returns the new root.
+   int link( int a, int b );
+
+   // Combines a list of sibling subtrees into one tree.
+   int mergePairs( int first );
+};
+
+// default constructor
+PairingHeap::PairingHeap()
+	: pool{ make_shared<PairingPool>() }, root{ -1 }, hSize{ 0 }
+{
+}
+
+// constructor which keeps its nodes in a shared pool
+PairingHeap::PairingHeap(const shared_ptr<PairingPool>& pool)
+	: pool{ pool }, root{ -1 }, hSize{ 0 }
+{
+}
+
+// Move constructor, takes the tree of 'other', which is left empty in the same pool
+PairingHeap::PairingHeap(PairingHeap&& other) noexcept
+	: pool{ other.pool }, root{ other.root }, hSize{ other.hSize }
+{
+	other.root = -1;
+	other.hSize = 0;
+}
+
+// Move assignment, returns this heap's nodes to its pool and takes the tree and pool of 'other'
+PairingHeap& PairingHeap::operator=(PairingHeap&& other) noexcept
+{
+	if (this == &other) { return *this; }
+
+	clear();
+	pool = other.pool;
+	root = other.root;
+	hSize = other.hSize;
+	other.root = -1;
+	other.hSize = 0;
+	return *this;
+}
+
+// Destructor
+PairingHeap::~PairingHeap()
+{
+	clear();
+}
+
+// Modifiers
+
+// links a new one node tree with the root
+// PRE: n/a
+// POST: new pair is in the heap, always returns true
+bool PairingHeap::insert(int element, int priority)
+{
+	int n = pool->allocate(element, priority);
+	root = (root < 0) ? n : link(root, n);
+	hSize++;
+	return true;
+}
+
+// Removes the element with highest priority and stores it in 'element', then rebuilds the tree out of the root's children
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if the heap is empty
+bool PairingHeap::extractMin(int& element)
+{
+	if (hSize <= 0) { return false; }
+
+	element = pool->nodes[root].element;
+	int children = pool->nodes[root].child;
+	pool->release(root);
+	root = mergePairs(children);
+	hSize--;
+	return true;
+}
+
+// Removes and returns the element with highest priority.
+// PRE: there is at least 1 pair to extract element from
+// POST: returns the element with the highest priority and removes that pair, returns 0 if the heap is empty
+int PairingHeap::extractMin()
+{
+	int retVal{ 0 };
+	extractMin(retVal);
+	return retVal;
+}
+
+// Links the root of 'other' with this root when both use the same pool, otherwise copies the other heap's nodes in
+// PRE: n/a
+// POST: this heap holds the pairs of both, 'other' is empty
+void PairingHeap::meld(PairingHeap& other)
+{
+	if (this == &other || other.root < 0) { return; }
+
+	if (pool == other.pool) {
+		root = (root < 0) ? other.root : link(root, other.root);
+		hSize += other.hSize;
+		other.root = -1;
+		other.hSize = 0;
+		return;
+	}
+
+	vector<int> stack(1, other.root); // walk the other tree, inserting every node into this pool
+	while (!stack.empty()) {
+		PairingPool::Node n = other.pool->nodes[stack.back()];
+		stack.pop_back();
+		insert(n.element, n.priority);
+		if (n.child >= 0) { stack.push_back(n.child); }
+		if (n.sibling >= 0) { stack.push_back(n.sibling); }
+	}
+	other.clear();
+}
+
+// Returns every node to the pool, iteratively so deep trees cannot overflow the stack
+// PRE: n/a
+// POST: heap is empty
+void PairingHeap::clear()
+{
+	if (root < 0) { return; }
+
+	vector<int> stack(1, root);
+	while (!stack.empty()) {
+		int i = stack.back();
+		stack.pop_back();
+		if (pool->nodes[i].child >= 0) { stack.push_back(pool->nodes[i].child); }
+		if (pool->nodes[i].sibling >= 0) { stack.push_back(pool->nodes[i].sibling); }
+		pool->release(i);
+	}
+	root = -1;
+	hSize = 0;
+}
+
+// Links two trees, the root with the larger priority becomes the first child of the other
+// PRE: a and b are roots, neither has siblings
+// POST: returns the root of the combined tree
+int PairingHeap::link(int a, int b)
+{
+	vector<PairingPool::Node>& nodes = pool->nodes;
+	if (nodes[b].priority < nodes[a].priority) { int t = a; a = b; b = t; }
+	nodes[b].sibling = nodes[a].child;
+	nodes[a].child = b;
+	return a;
+}
+
+// Two pass pairing: links the siblings left to right in pairs, then links the pairs into one tree right to left.
+// The first pass stacks up the pairs through their sibling links so no extra memory is needed.
+// PRE: 'first' is the first of a list of siblings, or -1
+// POST: returns the root of one tree holding all of them, -1 for an empty list
+int PairingHeap::mergePairs(int first)
+{
+	vector<PairingPool::Node>& nodes = pool->nodes;
+
+	int pairs = -1; // last pair linked, each one's sibling is the pair before it
+	while (first >= 0) {
+		int a = first;
+		int b = nodes[a].sibling;
+		if (b < 0) { // odd one out
+			nodes[a].sibling = pairs;
+			pairs = a;
+			break;
+		}
+		first = nodes[b].sibling;
+		nodes[a].sibling = -1;
+		nodes[b].sibling = -1;
+		int m = link(a, b);
+		nodes[m].sibling = pairs;
+		pairs = m;
+	}
+
+	int result = -1;
+	while (pairs >= 0) { // right to left
+		int next = nodes[pairs].sibling;
+		nodes[pairs].sibling = -1;
+		result = (result < 0) ? pairs : link(result, pairs);
+		pairs = next;
+	}
+	return result;
+}
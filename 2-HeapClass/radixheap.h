@@ -0,0 +1,268 @@
+/******************************************************
+  RadixHeap.h -- Declarations for Monotone Integer Priority Queues
+
+  Two drop-in replacements for Heap when priorities are monotone: no pair is
+  ever inserted with a priority below the last one extracted, as in event
+  simulation or Dijkstra with non-negative integer weights. Both keep Heap's
+  insert/extractMin/peekMin surface, and insert returns false instead of
+  accepting a priority that breaks monotonicity.
+
+  RadixHeap: 33 buckets, a pair goes in bucket i when its priority first
+  differs from the last extracted priority in bit i-1. Insert is O(1);
+  extractMin is amortized O(log C) for priorities spanning a range C,
+  since a pair only ever moves to lower buckets.
+
+  BucketQueue: C buckets used as a ring (Dial's algorithm), for when every
+  priority in the queue is within C-1 of the smallest, e.g. shortest paths
+  with edge weights below C. Insert is O(1), extractMin O(1) plus the empty
+  buckets skipped.
+
+  In both, peeking while the next minimum is not found yet has to look for
+  it without moving anything (that would raise the bound for inserts), so
+  peekMin is O(1) right after an extractMin of a repeated priority and
+  otherwise costs about as much as the extractMin that follows it.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <climits>
+using namespace std;
+
+class RadixHeap{
+
+public:
+   // New empty RadixHeap, any int priority can be inserted until the first extractMin.
+   RadixHeap();
+
+   // Accessors
+   bool empty() const { return hSize == 0; } // True iff RadixHeap is empty.
+   int size() const { return hSize; } // Current size of RadixHeap.
+   int peekMin() const { return top().element; } // Peek at minimum priority element.
+   int peekMinPriority() const { return fromKey(top().key); } // Peek at minimum priority.
+
+   // Modifiers
+   // Insert the pair <element,priority>. Returns false if priority is below the
+   // last extracted priority.
+   bool insert( int element, int priority );
+   // Remove the minimum priority element and store it in element.
+   // Returns false, and changes nothing, if empty.
+   bool extractMin( int & element );
+   // Remove and return the minimum priority element.
+   // Requires: !empty(). Returns 0 and changes nothing when empty.
+   int extractMin();
+
+private:
+   class Pair{
+      public:
+        int element ;
+        unsigned key ; // priority with the sign bit flipped, so unsigned order is int order
+   };
+
+   static const int BUCKETS = 33 ;
+
+   vector<Pair> buckets[BUCKETS] ; // bucket 0 holds pairs with key == last
+   unsigned last ; // key of the last extracted priority, every key in the heap is >= last
+   int hSize ;
+
+   static unsigned toKey( int priority ) { return static_cast<unsigned>(priority) ^ 0x80000000u; }
+   static int fromKey( unsigned key ) { return static_cast<int>(key ^ 0x80000000u); }
+
+   // Bucket for 'key', the position of the highest bit in which it differs from 'last'.
+   int bucketOf( unsigned key ) const;
+
+   // First non-empty bucket, BUCKETS if the heap is empty.
+   int firstBucket() const;
+
+   // Pair with the minimum key. Requires: !empty().
+   const Pair & top() const;
+};
+
+// default constructor, key 0 is INT_MIN so every priority is allowed
+RadixHeap::RadixHeap()
+	: last{ 0 }, hSize{ 0 }
+{
+}
+
+// PRE: key >= last
+// POST: returns 0 if key == last, else 1 + the index of the highest bit where key and last differ
+int RadixHeap::bucketOf(unsigned key) const
+{
+	unsigned diff = key ^ last;
+#if defined(__GNUC__)
+	return (diff == 0) ? 0 : 32 - __builtin_clz(diff);
+#else
+	int bits = 0;
+	for (; diff != 0; diff >>= 1) { bits++; }
+	return bits;
+#endif
+}
+
+// PRE: n/a
+// POST: returns the index of the first non-empty bucket, BUCKETS if there is none
+int RadixHeap::firstBucket() const
+{
+	int i = 0;
+	while (i < BUCKETS && buckets[i].empty()) { i++; }
+	return i;
+}
+
+// Keys in a lower bucket are always smaller, so the minimum is the smallest key of the first non-empty bucket
+// PRE: heap is not empty
+// POST: returns the pair with the minimum key, O(1) if it is in bucket 0
+const RadixHeap::Pair& RadixHeap::top() const
+{
+	const vector<Pair>& b = buckets[firstBucket()];
+	int best = static_cast<int>(b.size()) - 1;
+	for (int j = best - 1; j >= 0; j--) { if (b[j].key < b[best].key) { best = j; } }
+	return b[best];
+}
+
+// adds the pair to the bucket for its priority, no comparisons with other pairs
+// PRE: n/a
+// POST: returns false and changes nothing if 'priority' is below the last extracted priority
+bool RadixHeap::insert(int element, int priority)
+{
+	unsigned key = toKey(priority);
+	if (key < last) { return false; }
+
+	buckets[bucketOf(key)].push_back(Pair{ element, key });
+	hSize++;
+	return true;
+}
+
+// Takes the pair from bucket 0, after refilling bucket 0 if it is empty: the smallest key of the first non-empty
+// bucket i becomes the new 'last', and every pair in bucket i agrees with it above bit i-1, so spreading bucket i
+// out again puts each pair in a lower bucket and the minimum ones in bucket 0. A pair moves down at most 32 times
+// in its life, which pays for the scans.
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if the heap is empty
+bool RadixHeap::extractMin(int& element)
+{
+	if (hSize <= 0) { return false; }
+
+	if (buckets[0].empty()) {
+		int i = firstBucket();
+		last = top().key;
+
+		vector<Pair> moving;
+		moving.swap(buckets[i]);
+		for (const Pair& p : moving) { buckets[bucketOf(p.key)].push_back(p); }
+		moving.clear();
+		moving.swap(buckets[i]); // keep the bucket's memory for the next time it fills
+	}
+
+	element = buckets[0].back().element;
+	buckets[0].pop_back();
+	hSize--;
+	return true;
+}
+
+// Removes and returns the element with the minimum priority.
+// PRE: there is at least 1 pair to extract element from
+// POST: returns the element with the minimum priority and removes that pair, returns 0 if the heap is empty
+int RadixHeap::extractMin()
+{
+	int retVal{ 0 };
+	extractMin(retVal);
+	return retVal;
+}
+
+class BucketQueue{
+
+public:
+   // New empty BucketQueue for priorities that stay within a window of c
+   // values: every priority in the queue is less than the minimum plus c.
+   BucketQueue(int c);
+
+   // Accessors
+   bool empty() const { return hSize == 0; } // True iff BucketQueue is empty.
+   int size() const { return hSize; } // Current size of BucketQueue.
+   int peekMin() const { return buckets[slot(firstPriority())].back(); } // Peek at minimum priority element.
+   int peekMinPriority() const { return firstPriority(); } // Peek at minimum priority.
+
+   // Modifiers
+   // Insert the pair <element,priority>. Returns false if priority is below the
+   // last extracted priority, or would stretch the queue over more than c values.
+   bool insert( int element, int priority );
+   // Remove the minimum priority element and store it in element.
+   // Returns false, and changes nothing, if empty.
+   bool extractMin( int & element );
+   // Remove and return the minimum priority element.
+   // Requires: !empty(). Returns 0 and changes nothing when empty.
+   int extractMin();
+
+private:
+   vector< vector<int> > buckets ; // buckets[slot(p)] holds the elements with priority p
+   int window ;
+   int last ; // last extracted priority, INT_MIN before the first extractMin
+   int lo ; // no priority in the queue is below lo, and lo >= last
+   int hi ; // no priority in the queue is above hi
+   int hSize ;
+
+   // Bucket for priority p, p modulo the window, also for negative p.
+   int slot( int p ) const { return ((p % window) + window) % window; }
+
+   // Minimum priority in the queue, found by walking the ring from lo. Requires: !empty().
+   int firstPriority() const;
+};
+
+// constructor which makes a ring of c buckets
+BucketQueue::BucketQueue(int c)
+	: buckets(c > 0 ? c : 1), window{ c > 0 ? c : 1 }, last{ INT_MIN }, lo{ 0 }, hi{ 0 }, hSize{ 0 }
+{
+}
+
+// PRE: queue is not empty
+// POST: returns the minimum priority in the queue
+int BucketQueue::firstPriority() const
+{
+	int p = lo;
+	while (buckets[slot(p)].empty()) { p++; }
+	return p;
+}
+
+// adds the element to the bucket for its priority. Buckets are indexed by absolute priority, so the window can slide
+// down to a new minimum without moving anything, as long as everything still fits in it
+// PRE: n/a
+// POST: returns false and changes nothing if 'priority' is below the last extracted one or outside the window
+bool BucketQueue::insert(int element, int priority)
+{
+	if (priority < last) { return false; }
+
+	int newLo = (hSize == 0) ? priority : min(lo, priority);
+	int newHi = (hSize == 0) ? priority : max(hi, priority);
+	if (static_cast<long long>(newHi) - newLo >= window) { return false; }
+
+	lo = newLo;
+	hi = newHi;
+	buckets[slot(priority)].push_back(element);
+	hSize++;
+	return true;
+}
+
+// Moves lo along the ring to the first non-empty bucket and removes an element from it
+// PRE: n/a
+// POST: returns false and leaves 'element' alone if the queue is empty
+bool BucketQueue::extractMin(int& element)
+{
+	if (hSize <= 0) { return false; }
+
+	lo = firstPriority();
+	vector<int>& bucket = buckets[slot(lo)];
+	element = bucket.back();
+	bucket.pop_back();
+	last = lo;
+	hSize--;
+	return true;
+}
+
+// Removes and returns the element with the minimum priority.
+// PRE: there is at least 1 pair to extract element from
+// POST: returns the element with the minimum priority and removes it, returns 0 if the queue is empty
+int BucketQueue::extractMin()
+{
+	int retVal{ 0 };
+	extractMin(retVal);
+	return retVal;
+}
@@ -0,0 +1,96 @@
+/*************************************************************
+   Test Program for Radix Heap and Bucket Queue Classes
+**************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include "radixheap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Runs a monotone workload on Q: every insert is at least the last extracted
+// priority and less than it plus 'spread'. Checks each extraction against a model.
+template <class Q>
+bool monotoneTest( Q & H, int start, int spread ){
+      vector<int> model ; // priorities still in the queue
+      vector<int> prio(30000) ; // priority of each element
+      int last = start, next = 0 ;
+      for( int op = 0 ; op < 30000 ; op++ ){
+         if( rand() % 3 != 0 || model.empty() ){
+            int p = last + rand() % spread ;
+            prio[next] = p ;
+            if( !H.insert( next++, p ) ) return false ;
+            model.push_back(p);
+         }
+         else{
+            vector<int>::iterator m = min_element( model.begin(), model.end() );
+            if( H.peekMinPriority() != *m || prio[H.peekMin()] != *m ) return false ;
+            int e ;
+            if( !H.extractMin(e) || prio[e] != *m ) return false ;
+            last = *m ;
+            model.erase(m);
+         }
+         if( H.size() != (int)model.size() ) return false ;
+      }
+      return true ;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x ;
+
+      // Test RadixHeap basics, including negative priorities and monotonicity
+      OK = true ;
+      RadixHeap R ;
+      R.insert(91,-7);
+      R.insert(92,6);
+      R.insert(93,-8);
+      R.insert(94,1000000);
+      if( R.peekMin() != 93 || R.peekMinPriority() != -8 || R.size() != 4 ) OK = false ;
+      if( R.extractMin() != 93 ) OK = false ;
+      if( R.insert(95,-9) ) OK = false ; // below -8, the last extracted
+      if( !R.insert(96,-8) || R.peekMin() != 96 ) OK = false ;
+      R.extractMin(x);
+      R.extractMin(x);
+      if( x != 91 ) OK = false ;
+      R.extractMin(x);
+      if( x != 92 || R.extractMin() != 94 || !R.empty() || R.extractMin(x) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test BucketQueue basics, including the window
+      OK = true ;
+      BucketQueue B(10) ;
+      B.insert(91,107);
+      B.insert(92,103);
+      if( B.insert(93,113) ) OK = false ; // outside 103 .. 112
+      if( B.peekMin() != 92 || B.peekMinPriority() != 103 ) OK = false ;
+      B.extractMin(x);
+      if( B.insert(94,102) ) OK = false ; // below the last extracted
+      if( !B.insert(93,112) || B.peekMin() != 91 ) OK = false ;
+      B.extractMin(x);
+      B.extractMin(x);
+      if( x != 93 || !B.empty() || B.extractMin(x) ) OK = false ;
+      if( !B.insert(95,5000) || B.peekMinPriority() != 5000 ) OK = false ; // empty, can jump ahead
+
+      cout << OK << endl ;
+
+      // Random monotone workloads
+      OK = true ;
+      srand(38);
+      RadixHeap R1, R2 ;
+      BucketQueue B1(1001), B2(7) ;
+      if( !monotoneTest( R1, 0, 1001 ) ) OK = false ;
+      if( !monotoneTest( R2, -2000000000, 1 << 24 ) ) OK = false ;
+      if( !monotoneTest( B1, 0, 1001 ) ) OK = false ;
+      if( !monotoneTest( B2, -50, 7 ) ) OK = false ;
+
+      cout << OK << endl ;
+}
@@ -0,0 +1,89 @@
+/*************************************************************
+   Test Program for MultiQueue Class
+**************************************************************/
+#include <iostream>
+#include <vector>
+#include <thread>
+#include "multiqueue.h"
+using namespace std;
+
+void heapTest();
+
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Each of 'threads' threads inserts 'per' distinct elements and extracts as many, then the
+// rest is drained. Returns false unless every element came out exactly once.
+bool concurrentTest( int threads, int per ){
+      MultiQueue M( threads );
+      vector< vector<int> > got( threads );
+      vector<thread> workers ;
+      for( int t = 0 ; t < threads ; t++ ){
+         workers.emplace_back( [&M, &got, t, per]{
+            for( int i = 0 ; i < per ; i++ ){
+               int e = t * per + i ;
+               M.insert( e, (e * 7919) % 100003 );
+               if( i % 2 == 1 ){
+                  int x ;
+                  if( M.extractMin(x) ) got[t].push_back(x);
+                  if( M.extractMin(x) ) got[t].push_back(x);
+               }
+            }
+         } );
+      }
+      for( thread & w : workers ) w.join();
+
+      vector<int> seen( threads * per, 0 );
+      int x ;
+      while( M.extractMin(x) ) seen[x]++ ;
+      for( const vector<int> & g : got ) for( int e : g ) seen[e]++ ;
+      for( int s : seen ) if( s != 1 ) return false ;
+      return M.empty() ;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x, p ;
+
+      // Test with a single Heap, which is an exact priority queue, same pairs as test2
+      OK = true ;
+      MultiQueue M1(1,1) ;
+      M1.insert(91,7);
+      M1.insert(92,6);
+      M1.insert(94,5);
+      M1.insert(93,8);
+      M1.insert(95,9);
+      if( M1.size() != 5 || M1.queues() != 1 ) OK = false ;
+      if( !M1.extractMin(x,p) || x != 94 || p != 5 ) OK = false ;
+      if( !M1.extractMin(x) || x != 92 ) OK = false ;
+      if( !M1.extractMin(x) || x != 91 ) OK = false ;
+      if( !M1.extractMin(x) || x != 93 ) OK = false ;
+      if( !M1.extractMin(x) || x != 95 ) OK = false ;
+      if( !M1.empty() || M1.extractMin(x) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test with many Heaps: everything comes out once, and the early extractions are small
+      OK = true ;
+      MultiQueue M2(4) ;
+      if( M2.queues() != 8 ) OK = false ;
+      for( int i = 0 ; i < 1000 ; i++ ) M2.insert( i, (i * 379) % 1000 );
+      vector<int> seen( 1000, 0 );
+      for( int i = 0 ; i < 1000 ; i++ ){
+         if( !M2.extractMin(x,p) || p != (x * 379) % 1000 ) OK = false ;
+         else seen[x]++ ;
+         if( i < 10 && p >= 200 ) OK = false ; // far from the top 10
+      }
+      for( int s : seen ) if( s != 1 ) OK = false ;
+      if( !M2.empty() || M2.extractMin(x) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test with threads inserting and extracting at the same time
+      OK = concurrentTest( 4, 20000 ) && concurrentTest( 8, 5000 ) ;
+
+      cout << OK << endl ;
+}
@@ -0,0 +1,90 @@
+/*************************************************************
+   Test Program for Heap Class replaceTop, pushPop,
+   extractMinBatch and peekTopK
+**************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "heap.h"
+using namespace std;
+
+void heapTest();
+
+int main(){
+      heapTest();
+      return 0;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int e[10], p[10] ;
+
+      // Test replaceTop and pushPop, same pairs as test2
+      OK = true ;
+      Heap H ;
+      if( H.replaceTop(90,1) || !H.empty() ) OK = false ;
+      if( H.pushPop(90,1) != 90 || !H.empty() ) OK = false ;
+      H.insert(91,7);
+      H.insert(92,6);
+      H.insert(94,5);
+      H.insert(93,8);
+      H.insert(95,9);
+      if( !H.replaceTop(96,10) || H.peekMin() != 92 || H.size() != 5 ) OK = false ; // 94 is gone
+      if( H.pushPop(97,2) != 97 || H.size() != 5 ) OK = false ; // smaller than the minimum
+      if( H.pushPop(98,7) != 92 || H.size() != 5 ) OK = false ; // 98 ties with 91, both stay
+      if( H.extractMinBatch(10,e,p) != 5 || !H.empty() ) OK = false ;
+      if( e[0] + e[1] != 91 + 98 || e[2] != 93 || e[3] != 95 || e[4] != 96 ) OK = false ;
+      if( p[0] != 7 || p[1] != 7 || p[2] != 8 || p[4] != 10 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test peekTopK leaves the heap alone, and matches extractMinBatch
+      OK = true ;
+      int pri[8] = { 40, 10, 70, 20, 60, 30, 80, 50 };
+      int ele[8] = { 4, 1, 7, 2, 6, 3, 8, 5 };
+      Heap H2( pri, ele, 8, 0 );
+      if( H2.peekTopK(0,e,p) != 0 || H2.extractMinBatch(-1,e) != 0 ) OK = false ;
+      if( H2.peekTopK(3,e,p) != 3 || H2.size() != 8 ) OK = false ;
+      if( e[0] != 1 || e[1] != 2 || e[2] != 3 || p[2] != 30 ) OK = false ;
+      if( H2.peekTopK(20,e) != 8 || e[7] != 8 ) OK = false ;
+      if( H2.extractMinBatch(3,e) != 3 || e[0] != 1 || e[2] != 3 || H2.peekMin() != 4 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Random runs against a sorted copy
+      OK = true ;
+      srand(40);
+      for( int run = 0 ; run < 50 && OK ; run++ ){
+         int n = 1 + rand() % 2000 ;
+         vector<int> P(n), E(n), model ;
+         for( int i = 0 ; i < n ; i++ ){ P[i] = rand() % 500 ; E[i] = i ; }
+         Heap R( P.data(), E.data(), n, 0 );
+         model = P ;
+         sort( model.begin(), model.end() );
+
+         int k = rand() % (n + 5) ;
+         vector<int> te(k+1), tp(k+1), be(k+1), bp(k+1) ;
+         int got = R.peekTopK( k, te.data(), tp.data() );
+         if( got != min(k,n) || R.size() != n ) OK = false ;
+         for( int j = 0 ; j < got ; j++ ) if( tp[j] != model[j] || P[te[j]] != tp[j] ) OK = false ;
+
+         // A merge-style loop: replace the top with a larger priority, then drain everything
+         for( int j = 0 ; j < 100 ; j++ ){
+            int np = R.peekMinPriority() + rand() % 50 ;
+            model.erase( model.begin() );
+            model.insert( upper_bound( model.begin(), model.end(), np ), np );
+            int top = R.peekMin() ;
+            int ne = n + j ;
+            P.push_back(np);
+            if( rand() % 2 ) R.replaceTop( ne, np );
+            else if( R.pushPop( ne, np ) != top && np != model[0] ) OK = false ;
+         }
+         vector<int> de(n), dp(n) ;
+         if( R.extractMinBatch( n, de.data(), dp.data() ) != n || !R.empty() ) OK = false ;
+         for( int j = 0 ; j < n ; j++ ) if( dp[j] != model[j] || P[de[j]] != dp[j] ) OK = false ;
+      }
+
+      cout << OK << endl ;
+}
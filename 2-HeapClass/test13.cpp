@@ -0,0 +1,101 @@
+/*************************************************************
+   Test Program for Loser Tree K-Way Merger
+**************************************************************/
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "losertree.h"
+using namespace std;
+
+void heapTest();
+
+int main(){
+      heapTest();
+      return 0;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x, in ;
+
+      // Test three small ranges, an empty one, and ties between inputs
+      OK = true ;
+      int a[] = { 1, 4, 4, 9 };
+      int b[] = { 2, 4, 10 };
+      int c[] = { 0 };
+      LoserTree T ;
+      T.addRange( a, a + 4 );
+      T.addRange( b, b );
+      T.addRange( b, b + 3 );
+      T.addRange( c, c + 1 );
+      if( T.inputs() != 4 ) OK = false ;
+      int want[] = { 0, 1, 2, 4, 4, 4, 9, 10 };
+      int from[] = { 3, 0, 2, 0, 0, 2, 0, 2 };
+      for( int i = 0 ; i < 8 ; i++ ){
+         if( !T.next(x,in) || x != want[i] || in != from[i] ) OK = false ;
+      }
+      if( T.next(x) ) OK = false ;
+      LoserTree E ;
+      if( E.next(x) || E.merge(&x,1) != 0 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test runs read back from files through small buffers, and a missing file
+      OK = true ;
+      srand(41);
+      vector<int> all ;
+      const char * names[3] = { "test13_run0.bin", "test13_run1.bin", "test13_run2.bin" };
+      for( int r = 0 ; r < 3 ; r++ ){
+         vector<int> run( 1000 + r * 517 );
+         for( int & v : run ) v = rand() % 5000 - 2500 ;
+         sort( run.begin(), run.end() );
+         all.insert( all.end(), run.begin(), run.end() );
+         FILE * f = fopen( names[r], "wb" );
+         if( f == nullptr ){ OK = false ; continue ; }
+         fwrite( run.data(), sizeof(int), run.size(), f );
+         fclose( f );
+      }
+      sort( all.begin(), all.end() );
+      {
+         FileSource f0( names[0], 7 ), f1( names[1], 64 ), f2( names[2] ), missing( "test13_none.bin" );
+         if( !f0.isOpen() || missing.isOpen() ) OK = false ;
+         LoserTree F ;
+         F.addSource( &f0 );
+         F.addSource( &missing );
+         F.addSource( &f1 );
+         F.addSource( &f2 );
+         vector<int> out ;
+         while( F.next(x) ) out.push_back(x);
+         if( out != all ) OK = false ;
+      }
+      for( int r = 0 ; r < 3 ; r++ ) remove( names[r] );
+
+      cout << OK << endl ;
+
+      // Random merges of up to 300 ranges, read in chunks
+      OK = true ;
+      for( int run = 0 ; run < 40 && OK ; run++ ){
+         int k = 1 + rand() % 300 ;
+         vector< vector<int> > ranges( k );
+         vector<int> model ;
+         LoserTree R ;
+         for( int i = 0 ; i < k ; i++ ){
+            ranges[i].resize( rand() % 50 );
+            for( int & v : ranges[i] ) v = rand() % 1000 ;
+            sort( ranges[i].begin(), ranges[i].end() );
+            model.insert( model.end(), ranges[i].begin(), ranges[i].end() );
+            R.addRange( ranges[i].data(), ranges[i].data() + ranges[i].size() );
+         }
+         sort( model.begin(), model.end() );
+         vector<int> out( model.size() + 10 );
+         long long got = 0, n ;
+         while( ( n = R.merge( out.data() + got, 1 + rand() % 100 ) ) > 0 ) got += n ;
+         out.resize( got );
+         if( out != model ) OK = false ;
+      }
+
+      cout << OK << endl ;
+}
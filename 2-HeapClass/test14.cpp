@@ -0,0 +1,88 @@
+/*************************************************************
+   Test Program for Timer Schedulers
+**************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "timerwheel.h"
+using namespace std;
+
+void heapTest();
+
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Schedules, cancels and advances on S: returns false if the wrong timers expire.
+bool basicTest( Scheduler & S ){
+      vector<int> out ;
+      int a = S.schedule( 91, 5 );
+      S.schedule( 92, 3 );
+      int c = S.schedule( 93, 70 );
+      S.schedule( 94, 5000 );
+      S.schedule( 95, 1000000 ); // far beyond the wheel
+      int f = S.schedule( 96, 2000000 );
+      if( S.size() != 6 ) return false ;
+      if( !S.cancel(c) || S.cancel(c) || !S.cancel(f) || S.size() != 4 ) return false ;
+      if( S.advance( 2, out ) != 0 || S.now() != 2 ) return false ;
+      if( S.advance( 5, out ) != 2 || out[0] != 92 || out[1] != 91 ) return false ;
+      if( S.cancel(a) ) return false ; // already expired
+      S.schedule( 97, 1 ); // in the past, expires at the next tick
+      if( S.advance( 6, out ) != 1 || out[2] != 97 ) return false ;
+      if( S.advance( 999999, out ) != 1 || out[3] != 94 ) return false ;
+      if( S.advance( 1000000, out ) != 1 || out[4] != 95 || S.size() != 0 ) return false ;
+      return S.advance( 3000000, out ) == 0 ;
+}
+
+void heapTest(){
+
+      bool OK ;
+
+      // Test both schedulers through the common interface
+      HeapScheduler HS ;
+      TimerWheel TW ;
+      OK = basicTest( HS ) && basicTest( TW ) ;
+
+      cout << OK << endl ;
+
+      // Random schedules, cancels and advances, the wheel must expire the same timers as the heap
+      OK = true ;
+      srand(43);
+      HeapScheduler H ;
+      TimerWheel W ;
+      vector<int> deadline ; // of each element
+      vector<int> hHandle, wHandle ;
+      int clock = 0 ;
+      for( int op = 0 ; op < 100000 && OK ; op++ ){
+         int r = rand() % 100 ;
+         if( r < 50 ){
+            int reach[4] = { 64, 4096, 1 << 18, 1 << 24 };
+            int d = clock + rand() % reach[ rand() % 4 ] ;
+            int e = (int)deadline.size() ;
+            deadline.push_back( max( d, clock + 1 ) );
+            hHandle.push_back( H.schedule( e, d ) );
+            wHandle.push_back( W.schedule( e, d ) );
+         }
+         else if( r < 75 && !deadline.empty() ){
+            int e = rand() % (int)deadline.size() ;
+            bool hc = H.cancel( hHandle[e] ), wc = W.cancel( wHandle[e] );
+            if( hc != wc ) OK = false ;
+            if( hc ) hHandle[e] = wHandle[e] = -1 ; // handles are reused, never cancel twice
+         }
+         else{
+            clock += ( rand() % 10 == 0 ) ? rand() % 100000 : rand() % 50 ;
+            vector<int> he, we ;
+            if( H.advance( clock, he ) != W.advance( clock, we ) ) OK = false ;
+            for( size_t i = 1 ; i < we.size() ; i++ ) if( deadline[we[i]] < deadline[we[i-1]] ) OK = false ;
+            for( int e : we ){ if( deadline[e] > clock ) OK = false ; hHandle[e] = wHandle[e] = -1 ; }
+            sort( he.begin(), he.end() );
+            sort( we.begin(), we.end() );
+            if( he != we ) OK = false ;
+         }
+         if( H.size() != W.size() || W.now() != clock ) OK = false ;
+      }
+
+      cout << OK << endl ;
+}
@@ -0,0 +1,75 @@
+/*************************************************************
+   Test Program for Basic Heap Class - Bulk Loading.
+**************************************************************/
+#include <iostream>
+#include "heap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Extracts everything from H, returns false if the priorities do not come out in order.
+bool drainsInOrder( Heap & H ){
+      int last = -2147483647 - 1 ;
+      while( !H.empty() ){
+         if( H.peekMinPriority() < last ) return false ;
+         last = H.peekMinPriority() ;
+         H.extractMin();
+      }
+      return true ;
+}
+
+void heapTest(){
+
+      bool OK ;
+      const int N = 1000 ;
+      int * ElementArr = new int[N];
+      int * PriorityArr = new int[N];
+      for( int i = 0 ; i < N ; i++ ){
+         PriorityArr[i] = (i * 7919) % N ; // every priority 0 .. N-1 once, scrambled
+         ElementArr[i] = 100000 + PriorityArr[i] ;
+      }
+
+      // Test Heap(P,E,s,c) on a larger input
+      OK = true ;
+      Heap H( PriorityArr, ElementArr, N, 5 );
+      if( H.size() != N || H.capacity() != N + 5 ) OK = false ;
+      if( H.peekMin() != 100000 || H.peekMinPriority() != 0 ) OK = false ;
+      if( !drainsInOrder(H) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test insertBatch, small batch into a big heap (trickled up)
+      OK = true ;
+      Heap H1( PriorityArr, ElementArr, N - 3, 3 );
+      H1.insertBatch( ElementArr + N - 3, PriorityArr + N - 3, 3 );
+      if( H1.size() != N ) OK = false ;
+      if( H1.peekMin() != 100000 || H1.peekMinPriority() != 0 ) OK = false ;
+      if( !drainsInOrder(H1) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test insertBatch, large batch into a small heap (heapified)
+      OK = true ;
+      Heap H2( N + 10 );
+      H2.insert( 7, -1 );
+      H2.insertBatch( ElementArr, PriorityArr, N );
+      if( H2.size() != N + 1 ) OK = false ;
+      if( H2.peekMin() != 7 || H2.peekMinPriority() != -1 ) OK = false ;
+      H2.extractMin();
+      if( H2.peekMin() != 100000 ) OK = false ;
+      if( !drainsInOrder(H2) ) OK = false ;
+
+      // An empty batch changes nothing
+      H2.insertBatch( ElementArr, PriorityArr, 0 );
+      if( H2.size() != 0 ) OK = false ;
+
+      cout << OK << endl ;
+
+      delete[] ElementArr;
+      delete[] PriorityArr;
+}
@@ -0,0 +1,90 @@
+/*************************************************************
+   Test Program for Basic Heap Class - Growth, Copy and Move.
+**************************************************************/
+#include <iostream>
+#include <vector>
+#include "heap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Builds a heap in a function and returns it, which moves instead of copying.
+Heap makeHeap( int n ){
+      Heap H(1);
+      for( int i = n ; i > 0 ; i-- ) H.insert( 100 + i, i );
+      return H;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x ;
+
+      // Test growing past the capacity
+      OK = true ;
+      Heap H(2);
+      for( int i = 0 ; i < 100 ; i++ ){
+         if( !H.insert( 1000 - i, 1000 - i ) ) OK = false ;
+      }
+      if( H.size() != 100 || H.capacity() < 100 ) OK = false ;
+      if( H.peekMin() != 901 || H.peekMinPriority() != 901 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test reserve and shrink_to_fit
+      OK = true ;
+      if( !H.reserve(500) || H.capacity() < 500 ) OK = false ;
+      if( !H.reserve(10) || H.capacity() < 500 ) OK = false ; // never shrinks
+      if( !H.shrink_to_fit() || H.capacity() != 100 ) OK = false ;
+      if( H.peekMin() != 901 || H.size() != 100 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test error returns on an empty heap
+      OK = true ;
+      Heap E;
+      x = -5 ;
+      if( E.extractMin(x) || x != -5 ) OK = false ;
+      if( E.extractMin() != 0 || E.size() != 0 ) OK = false ;
+      E.insert( 7, 1 );
+      if( !E.extractMin(x) || x != 7 || !E.empty() ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test copy constructor and copy assignment
+      OK = true ;
+      Heap C( H );
+      C.extractMin();
+      if( H.size() != 100 || C.size() != 99 ) OK = false ;
+      if( H.peekMin() != 901 || C.peekMin() != 902 ) OK = false ;
+      E = C ;
+      E = E ;
+      if( E.size() != 99 || E.peekMin() != 902 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test move constructor and move assignment
+      OK = true ;
+      Heap M = makeHeap(50);
+      if( M.size() != 50 || M.peekMin() != 101 ) OK = false ;
+      Heap M2( std::move(M) );
+      if( M.size() != 0 || M.capacity() != 0 || M2.size() != 50 ) OK = false ;
+      M = std::move(M2);
+      if( M.size() != 50 || M2.size() != 0 || M.peekMin() != 101 ) OK = false ;
+      M2.insert( 5, 5 ); // a moved-from heap is usable again
+      if( M2.size() != 1 || M2.peekMin() != 5 ) OK = false ;
+
+      // Heaps stored in a container
+      vector<Heap> heaps;
+      for( int i = 1 ; i <= 20 ; i++ ) heaps.push_back( makeHeap(i) );
+      for( int i = 0 ; i < 20 ; i++ ){
+         if( heaps[i].size() != i + 1 || heaps[i].peekMin() != 101 ) OK = false ;
+      }
+
+      cout << OK << endl ;
+}
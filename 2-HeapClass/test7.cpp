@@ -0,0 +1,85 @@
+/*************************************************************
+   Test Program for Indexed Heap Class
+**************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include "indexedheap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x = -1 ;
+
+      // Test insert, contains and extractMin
+      OK = true ;
+      IndexedHeap H;
+      H.insert(4,40);
+      H.insert(1,10);
+      H.insert(7,70);
+      H.insert(3,30);
+      if( H.insert(3,5) ) OK = false ; // already there
+      if( H.insert(-1,5) ) OK = false ; // not a handle
+      if( H.size() != 4 ) OK = false ;
+      if( !H.contains(7) || H.contains(2) || H.contains(100) ) OK = false ;
+      if( H.peekMin() != 1 || H.peekMinPriority() != 10 ) OK = false ;
+      if( !H.extractMin(x) || x != 1 || H.contains(1) ) OK = false ;
+      if( H.peekMin() != 3 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test decreaseKey, increaseKey and changePriority
+      OK = true ;
+      if( !H.decreaseKey(7,1) || H.peekMin() != 7 || H.priorityOf(7) != 1 ) OK = false ;
+      if( H.decreaseKey(7,2) ) OK = false ; // wrong direction
+      if( H.decreaseKey(9,2) ) OK = false ; // not there
+      if( !H.increaseKey(7,100) || H.peekMin() != 3 ) OK = false ;
+      if( H.increaseKey(3,1) ) OK = false ; // wrong direction
+      if( !H.changePriority(4,0) || H.peekMin() != 4 ) OK = false ;
+      if( !H.changePriority(4,50) || H.peekMin() != 3 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test erase
+      OK = true ;
+      if( !H.erase(3) || H.contains(3) || H.size() != 2 ) OK = false ;
+      if( H.erase(3) ) OK = false ;
+      if( H.peekMin() != 4 ) OK = false ;
+      H.extractMin(x);
+      H.extractMin(x);
+      if( x != 7 || !H.empty() || H.extractMin(x) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Random operations checked against a brute force minimum
+      OK = true ;
+      const int N = 300 ;
+      int prio[N] ;
+      bool in[N] = { false } ;
+      IndexedHeap R(N);
+      srand(35);
+      for( int op = 0 ; op < 20000 ; op++ ){
+         int e = rand() % N ;
+         int p = rand() % 1000 ;
+         switch( rand() % 4 ){
+            case 0: if( R.insert(e,p) != !in[e] ) OK = false ; if( !in[e] ){ in[e] = true ; prio[e] = p ; } break ;
+            case 1: if( R.changePriority(e,p) != in[e] ) OK = false ; if( in[e] ) prio[e] = p ; break ;
+            case 2: if( R.erase(e) != in[e] ) OK = false ; in[e] = false ; break ;
+            case 3: if( R.extractMin(x) ){ if( !in[x] ) OK = false ; in[x] = false ; for( int i = 0 ; i < N ; i++ ) if( in[i] && prio[i] < prio[x] ) OK = false ; } break ;
+         }
+         int count = 0 ;
+         for( int i = 0 ; i < N ; i++ ) if( in[i] ){ count++ ; if( !R.contains(i) || R.priorityOf(i) != prio[i] ) OK = false ; }
+         if( R.size() != count ) OK = false ;
+      }
+      R.clear();
+      if( !R.empty() || R.contains(0) ) OK = false ;
+
+      cout << OK << endl ;
+}
@@ -0,0 +1,87 @@
+/*************************************************************
+   Test Program for Templated d-ary Heap Class
+**************************************************************/
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include "dheap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Inserts n random priorities (with lots of ties) plus a heapified copy, checks both drain in sorted order.
+template <int D>
+bool randomTest( int n ){
+      vector<int> pri(n), ele(n);
+      for( int i = 0 ; i < n ; i++ ){ pri[i] = rand() % (n / 4 + 1) - n / 8 ; ele[i] = i ; }
+
+      DHeap<int,int,D> H ;
+      for( int i = 0 ; i < n ; i++ ) H.insert( ele[i], pri[i] );
+      DHeap<int,int,D> B( pri.data(), ele.data(), n );
+
+      vector<int> sorted = pri ;
+      sort( sorted.begin(), sorted.end() );
+      if( H.size() != n || B.size() != n ) return false ;
+      for( int i = 0 ; i < n ; i++ ){
+         int e, p, e2, p2 ;
+         if( !H.extractMin(e,p) || !B.extractMin(e2,p2) ) return false ;
+         if( p != sorted[i] || p2 != sorted[i] || pri[e] != p || pri[e2] != p2 ) return false ;
+      }
+      int e ;
+      return H.empty() && B.empty() && !H.extractMin(e) ;
+}
+
+void heapTest(){
+
+      bool OK ;
+
+      // Test the same small example as test1 on every arity
+      OK = true ;
+      DHeap<int,int,2> H2 ;
+      DHeap<int,int,4> H4 ;
+      DHeap<int,int,8> H8 ;
+      int pri[] = { 7, 6, 8, 5, 9 } ;
+      for( int i = 0 ; i < 5 ; i++ ){ H2.insert( 91 + i, pri[i] ); H4.insert( 91 + i, pri[i] ); H8.insert( 91 + i, pri[i] ); }
+      if( H2.peekMin() != 94 || H4.peekMin() != 94 || H8.peekMin() != 94 ) OK = false ;
+      if( H8.peekMinPriority() != 5 || H8.size() != 5 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Random tests, 8-ary with int priorities goes through the SIMD child scan
+      OK = true ;
+      srand(36);
+      for( int n = 1 ; n < 3000 ; n = n * 3 + 1 ){
+         if( !randomTest<2>(n) || !randomTest<3>(n) || !randomTest<4>(n) || !randomTest<8>(n) ) OK = false ;
+      }
+
+      cout << OK << endl ;
+
+      // Other types and a max-heap comparison
+      OK = true ;
+      DHeap<double,string,4,greater<double> > M ;
+      M.insert( "b", 2.5 );
+      M.insert( "d", 4.5 );
+      M.insert( "a", 1.5 );
+      M.insert( "c", 3.5 );
+      string s ;
+      double p ;
+      if( !M.extractMin(s,p) || s != "d" || p != 4.5 ) OK = false ;
+      if( M.peekMin() != "c" ) OK = false ;
+      M.clear();
+      if( !M.empty() ) OK = false ;
+
+      DHeap<int,int,8,greater<int> > G ; // int but not less<int>, must not use the SIMD min
+      for( int i = 0 ; i < 100 ; i++ ) G.insert( i, i );
+      for( int i = 99 ; i >= 0 ; i-- ){
+         int e ;
+         if( !G.extractMin(e) || e != i ) OK = false ;
+      }
+
+      cout << OK << endl ;
+}
@@ -0,0 +1,103 @@
+/*************************************************************
+   Test Program for Pairing Heap Class
+**************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include "pairingheap.h"
+using namespace std;
+
+void heapTest();
+ 
+int main(){
+      heapTest();
+      return 0;
+}
+
+// Extracts everything, returns false if the priorities are not the sorted contents of 'expected'.
+bool drainsAs( PairingHeap & H, vector<int> expected ){
+      sort( expected.begin(), expected.end() );
+      if( H.size() != (int)expected.size() ) return false ;
+      for( int p : expected ){
+         if( H.peekMinPriority() != p ) return false ;
+         H.extractMin();
+      }
+      return H.empty() ;
+}
+
+void heapTest(){
+
+      bool OK ;
+      int x ;
+
+      // Test insert, peek and extractMin, same pairs as test2
+      OK = true ;
+      PairingHeap H ;
+      H.insert(91,7);
+      H.insert(92,6);
+      H.insert(94,5);
+      H.insert(93,8);
+      H.insert(95,9);
+      H.insert(85,10);
+      H.insert(84,12);
+      H.insert(83,4);
+      H.insert(82,6);
+      H.insert(81,3);
+      if( H.size() != 10 || H.peekMin() != 81 || H.peekMinPriority() != 3 ) OK = false ;
+      if( !H.extractMin(x) || x != 81 ) OK = false ;
+      if( H.extractMin() != 83 ) OK = false ;
+      if( H.extractMin() != 94 ) OK = false ;
+      if( !drainsAs( H, vector<int>{ 6, 6, 7, 8, 9, 10, 12 } ) ) OK = false ;
+      if( H.extractMin(x) || H.extractMin() != 0 ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Test meld with a shared pool and with separate pools
+      OK = true ;
+      shared_ptr<PairingPool> pool = make_shared<PairingPool>();
+      PairingHeap A(pool), B(pool), C ;
+      vector<int> all ;
+      for( int i = 0 ; i < 50 ; i++ ){
+         A.insert( i, (i * 37) % 101 ); all.push_back( (i * 37) % 101 );
+         B.insert( i, (i * 53) % 97 ); all.push_back( (i * 53) % 97 );
+         C.insert( i, (i * 11) % 89 ); all.push_back( (i * 11) % 89 );
+      }
+      A.meld(B);
+      A.meld(C);
+      A.meld(A);
+      if( !B.empty() || !C.empty() || A.size() != 150 ) OK = false ;
+      B.insert( 1, -1 ); // melded-from heaps are usable again
+      A.meld(B);
+      all.push_back(-1);
+      if( A.peekMin() != 1 ) OK = false ;
+      if( !drainsAs( A, all ) ) OK = false ;
+
+      cout << OK << endl ;
+
+      // Random inserts, extracts and melds between heaps sharing a pool
+      OK = true ;
+      srand(37);
+      PairingHeap P[4] = { PairingHeap(pool), PairingHeap(pool), PairingHeap(pool), PairingHeap(pool) } ;
+      vector<int> model[4] ;
+      for( int op = 0 ; op < 20000 ; op++ ){
+         int h = rand() % 4 ;
+         int r = rand() % 10 ;
+         if( r < 6 ){ int p = rand() % 1000 ; P[h].insert( op, p ); model[h].push_back(p); }
+         else if( r < 9 ){
+            if( !model[h].empty() ){
+               vector<int>::iterator m = min_element( model[h].begin(), model[h].end() );
+               if( P[h].peekMinPriority() != *m ) OK = false ;
+               P[h].extractMin();
+               model[h].erase(m);
+            }
+         }
+         else{
+            int g = rand() % 4 ;
+            if( g != h ){ P[h].meld( P[g] ); model[h].insert( model[h].end(), model[g].begin(), model[g].end() ); model[g].clear(); }
+         }
+         if( P[h].size() != (int)model[h].size() ) OK = false ;
+      }
+      for( int h = 0 ; h < 4 ; h++ ) if( !drainsAs( P[h], model[h] ) ) OK = false ;
+
+      cout << OK << endl ;
+}
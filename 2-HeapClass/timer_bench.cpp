@@ -0,0 +1,71 @@
+/*************************************************************
+   Timer benchmark, HeapScheduler against TimerWheel on a
+   connection-timeout workload: every connection has an idle
+   timeout 'timeout' ticks ahead, and each tick a random set of
+   connections sees traffic, which cancels and reschedules its
+   timeout. Connections that time out reconnect at once. Most
+   timers are cancelled long before they expire.
+   Usage: timer_bench [connections] [ticks] [active per tick] [timeout]
+**************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "timerwheel.h"
+using namespace std;
+
+const int G_WIDTH = 16 ;
+
+// Runs the workload on S, returns the number of expired timers and sets the seconds taken and
+// the number of schedule and cancel calls.
+long long run( Scheduler & S, int connections, int ticks, int active, int timeout, double & seconds, long long & ops ){
+      mt19937 gen(43);
+      vector<int> handle( connections );
+      vector<int> expired ;
+      long long timeouts = 0 ;
+      ops = 0 ;
+
+      auto start = chrono::high_resolution_clock::now();
+      for( int c = 0 ; c < connections ; c++ ) handle[c] = S.schedule( c, 1 + (int)(gen() % timeout) );
+      ops += connections ;
+      for( int t = 1 ; t <= ticks ; t++ ){
+         for( int i = 0 ; i < active ; i++ ){
+            int c = (int)(gen() % connections) ;
+            S.cancel( handle[c] );
+            handle[c] = S.schedule( c, t + timeout );
+         }
+         ops += 2LL * active ;
+         expired.clear();
+         timeouts += S.advance( t, expired );
+         for( int c : expired ) handle[c] = S.schedule( c, t + timeout );
+         ops += expired.size();
+      }
+      seconds = chrono::duration<double>( chrono::high_resolution_clock::now() - start ).count();
+      return timeouts ;
+}
+
+int main( int argc, char * argv[] ){
+      int connections = (argc > 1) ? atoi(argv[1]) : 1000000 ;
+      int ticks = (argc > 2) ? atoi(argv[2]) : 20000 ;
+      int active = (argc > 3) ? atoi(argv[3]) : 1000 ;
+      int timeout = (argc > 4) ? atoi(argv[4]) : 30000 ;
+
+      cout << "connections: " << connections << ", ticks: " << ticks << ", active/tick: " << active
+           << ", timeout: " << timeout << " ticks" << endl ;
+      cout << left << setw(G_WIDTH) << "Scheduler" << setw(G_WIDTH) << "seconds" << setw(G_WIDTH) << "ns/op" << setw(G_WIDTH) << "timeouts" << endl ;
+
+      double seconds ;
+      long long ops ;
+      HeapScheduler H ;
+      long long heapTimeouts = run( H, connections, ticks, active, timeout, seconds, ops );
+      cout << left << setw(G_WIDTH) << "HeapScheduler" << setw(G_WIDTH) << seconds << setw(G_WIDTH) << seconds * 1e9 / ops << setw(G_WIDTH) << heapTimeouts << endl ;
+
+      TimerWheel W ;
+      long long wheelTimeouts = run( W, connections, ticks, active, timeout, seconds, ops );
+      cout << left << setw(G_WIDTH) << "TimerWheel" << setw(G_WIDTH) << seconds << setw(G_WIDTH) << seconds * 1e9 / ops << setw(G_WIDTH) << wheelTimeouts << endl ;
+
+      if( heapTimeouts != wheelTimeouts ){ cout << "schedulers disagree" << endl ; return 1 ; }
+      return 0 ;
+}
@@ -0,0 +1,304 @@
+/******************************************************
+  TimerWheel.h -- Declarations for Timer Schedulers
+
+  Scheduler is the common interface of a timer queue: schedule an element
+  to expire at an integer tick, cancel it by the handle that schedule
+  returned, and advance the clock, collecting what expired. Expired
+  elements come out in deadline order, in any order within one tick.
+
+  HeapScheduler keeps the timers in an IndexedHeap with priority = deadline,
+  so schedule and cancel are O(log n).
+
+  TimerWheel is a hierarchical timing wheel, after Varghese and Lauck,
+  "Hashed and Hierarchical Timing Wheels" (SOSP 1987): 3 levels of 64
+  slots, each slot an intrusive doubly-linked list of timers. A timer due
+  within 64 ticks goes in level 0 at its exact tick, within 64^2 in level 1
+  and within 64^3 in level 2, at the slot of its 64- or 4096-tick span;
+  when the clock enters a span its slot is cascaded into the levels below.
+  Timers further out wait in a Heap and move into the wheel once they are
+  within range. Schedule and cancel are O(1), and advance costs one step
+  per tick plus O(1) per timer cascaded or expired, skipping ahead while
+  the wheel is empty.
+*******************************************************/
+#pragma once
+#include <iostream>
+#include <vector>
+#include "heap.h"
+#include "indexedheap.h"
+using namespace std;
+
+class Scheduler{
+
+public:
+   virtual ~Scheduler() {}
+
+   // Schedule 'element' to expire at tick 'deadline', or at the next tick if that
+   // has passed. Returns a handle for cancel().
+   virtual int schedule( int element, int deadline ) = 0;
+   // Cancel the timer with this handle. Returns false if it already expired or was
+   // cancelled. Handles are reused once their timer is gone.
+   virtual bool cancel( int handle ) = 0;
+   // Move the clock to tick 'now', appending the elements of every timer with a
+   // deadline <= now to 'expired'. Returns how many were appended.
+   virtual int advance( int now, vector<int> & expired ) = 0;
+
+   virtual int size() const = 0; // Number of pending timers.
+   virtual int now() const = 0; // Current tick, 0 at the start.
+};
+
+class HeapScheduler : public Scheduler{
+
+public:
+   HeapScheduler() : clock{ 0 } {}
+
+   int schedule( int element, int deadline ) override;
+   bool cancel( int handle ) override;
+   int advance( int now, vector<int> & expired ) override;
+   int size() const override { return H.size(); }
+   int now() const override { return clock; }
+
+private:
+   IndexedHeap H ; // <handle,deadline>
+   vector<int> elementOf ; // element of each handle
+   vector<int> freeHandles ;
+   int clock ;
+};
+
+// takes a free handle and inserts it with the deadline as priority
+// PRE: n/a
+// POST: returns the handle of the new timer
+int HeapScheduler::schedule(int element, int deadline)
+{
+	int handle;
+	if (!freeHandles.empty()) { handle = freeHandles.back(); freeHandles.pop_back(); }
+	else { handle = static_cast<int>(elementOf.size()); elementOf.push_back(0); }
+
+	elementOf[handle] = element;
+	H.insert(handle, max(deadline, clock + 1));
+	return handle;
+}
+
+// PRE: n/a
+// POST: the timer is removed and its handle freed, returns false if it was not pending
+bool HeapScheduler::cancel(int handle)
+{
+	if (handle < 0 || !H.erase(handle)) { return false; }
+	freeHandles.push_back(handle);
+	return true;
+}
+
+// PRE: now >= now()
+// POST: every timer due by 'now' is extracted and appended in deadline order, returns how many
+int HeapScheduler::advance(int now, vector<int>& expired)
+{
+	int count{ 0 };
+	if (now > clock) { clock = now; }
+
+	int handle;
+	while (!H.empty() && H.peekMinPriority() <= clock && H.extractMin(handle)) {
+		expired.push_back(elementOf[handle]);
+		freeHandles.push_back(handle);
+		count++;
+	}
+	return count;
+}
+
+class TimerWheel : public Scheduler{
+
+public:
+   TimerWheel();
+
+   int schedule( int element, int deadline ) override;
+   bool cancel( int handle ) override;
+   int advance( int now, vector<int> & expired ) override;
+   int size() const override { return pending; }
+   int now() const override { return clock; }
+
+private:
+   static const int BITS = 6 ;
+   static const int SLOTS = 1 << BITS ; // slots per level
+   static const int LEVELS = 3 ;
+   static const int RANGE = 1 << (BITS * LEVELS) ; // deadlines this far ahead go in the far Heap
+
+   static const int FREE = -1 ; // timer slot values that are not a wheel slot
+   static const int FAR = -2 ;
+   static const int FAR_CANCELLED = -3 ;
+
+   class Timer{
+      public:
+        int element ;
+        int deadline ;
+        int slot ; // level * SLOTS + index in the wheel, or FREE, FAR, FAR_CANCELLED
+        int prev ; // neighbours in the slot's list, -1 for none. next links the free list.
+        int next ;
+   };
+
+   vector<Timer> timers ; // indexed by handle
+   int freeHead ;
+   int heads[LEVELS * SLOTS] ; // first timer of each slot, -1 for empty
+   Heap far ; // <handle,deadline> for timers RANGE or more ticks ahead when scheduled
+   int clock ;
+   int pending ; // live timers, in the wheel or far
+   int inWheel ;
+
+   // Links timer h into the slot for its deadline relative to the clock, or into 'far'.
+   void place( int h );
+   void unlink( int h );
+   void release( int h );
+
+   // Empties slot 'level' at the clock's current index and places its timers again.
+   void cascade( int level );
+};
+
+// constructor with an empty wheel at tick 0
+TimerWheel::TimerWheel()
+	: freeHead{ -1 }, clock{ 0 }, pending{ 0 }, inWheel{ 0 }
+{
+	for (int& h : heads) { h = -1; }
+}
+
+// Level i holds deadlines less than SLOTS^(i+1) ticks ahead, indexed by bits [BITS*i, BITS*(i+1)) of the deadline.
+// Its slot for the deadline is reached exactly when the clock enters the deadline's span at that level, since the
+// deadline is at most SLOTS spans ahead.
+// PRE: timer h is not linked anywhere, its deadline is after the clock
+// POST: h is at the head of its slot's list, or in 'far' if it is RANGE or more ticks ahead
+void TimerWheel::place(int h)
+{
+	Timer& t = timers[h];
+	long long delta = static_cast<long long>(t.deadline) - clock;
+	if (delta >= RANGE) {
+		t.slot = FAR;
+		far.insert(h, t.deadline);
+		return;
+	}
+
+	int level = 0;
+	while (delta >= (1LL << (BITS * (level + 1)))) { level++; }
+	t.slot = level * SLOTS + ((t.deadline >> (BITS * level)) & (SLOTS - 1));
+	t.prev = -1;
+	t.next = heads[t.slot];
+	if (t.next >= 0) { timers[t.next].prev = h; }
+	heads[t.slot] = h;
+	inWheel++;
+}
+
+// PRE: timer h is linked into a wheel slot
+// POST: h is out of the slot's list
+void TimerWheel::unlink(int h)
+{
+	Timer& t = timers[h];
+	if (t.prev >= 0) { timers[t.prev].next = t.next; }
+	else { heads[t.slot] = t.next; }
+	if (t.next >= 0) { timers[t.next].prev = t.prev; }
+	inWheel--;
+}
+
+// PRE: timer h is not linked anywhere
+// POST: h is on the free list
+void TimerWheel::release(int h)
+{
+	timers[h].slot = FREE;
+	timers[h].next = freeHead;
+	freeHead = h;
+}
+
+// takes a free timer and links it into its slot
+// PRE: n/a
+// POST: returns the handle of the new timer
+int TimerWheel::schedule(int element, int deadline)
+{
+	int h = freeHead;
+	if (h >= 0) { freeHead = timers[h].next; }
+	else { h = static_cast<int>(timers.size()); timers.push_back(Timer()); }
+
+	timers[h].element = element;
+	timers[h].deadline = max(deadline, clock + 1);
+	place(h);
+	pending++;
+	return h;
+}
+
+// A timer in the wheel is unlinked at once. One in 'far' cannot be taken out of the Heap cheaply, so it is only
+// marked, and freed when advance() pops it; until then its handle is not reused.
+// PRE: n/a
+// POST: the timer will not expire, returns false if it was not pending
+bool TimerWheel::cancel(int handle)
+{
+	if (handle < 0 || handle >= static_cast<int>(timers.size())) { return false; }
+
+	Timer& t = timers[handle];
+	if (t.slot == FREE || t.slot == FAR_CANCELLED) { return false; }
+
+	if (t.slot == FAR) { t.slot = FAR_CANCELLED; }
+	else {
+		unlink(handle);
+		release(handle);
+	}
+	pending--;
+	return true;
+}
+
+// PRE: the clock has just entered a new span at 'level'
+// POST: every timer of the level's current slot is placed again, now less than one span ahead
+void TimerWheel::cascade(int level)
+{
+	int slot = level * SLOTS + ((clock >> (BITS * level)) & (SLOTS - 1));
+	int h = heads[slot];
+	heads[slot] = -1;
+	while (h >= 0) {
+		int next = timers[h].next;
+		inWheel--;
+		place(h);
+		h = next;
+	}
+}
+
+// Steps the clock one tick at a time. On entering a new level 2 span, far timers now within RANGE move into the
+// wheel; then the slots whose span starts at this tick are cascaded, top level first, so the level 0 slot holds
+// exactly the timers due at this tick. While the wheel is empty the clock jumps to the tick before the next far
+// timer comes in range.
+// PRE: now >= now()
+// POST: the clock is at 'now' and every timer due by then is appended in deadline order, returns how many
+int TimerWheel::advance(int now, vector<int>& expired)
+{
+	int count{ 0 };
+	const int TOP = BITS * (LEVELS - 1); // a new level 2 span starts every 2^TOP ticks
+
+	while (clock < now) {
+		if (inWheel == 0) {
+			long long skip = now;
+			if (!far.empty()) {
+				long long inRange = static_cast<long long>(far.peekMinPriority()) - RANGE; // first tick it fits after
+				long long arrive = ((inRange >> TOP) + 1) << TOP;
+				skip = min(skip, arrive - 1);
+			}
+			if (skip > clock) { clock = static_cast<int>(skip); continue; }
+		}
+
+		clock++;
+		if ((clock & ((1 << TOP) - 1)) == 0) {
+			int h;
+			while (!far.empty() && static_cast<long long>(far.peekMinPriority()) - clock < RANGE && far.extractMin(h)) {
+				if (timers[h].slot == FAR_CANCELLED) { release(h); }
+				else { place(h); }
+			}
+		}
+		for (int level{ LEVELS - 1 }; level >= 1; level--) {
+			if ((clock & ((1 << (BITS * level)) - 1)) == 0) { cascade(level); }
+		}
+
+		int slot = clock & (SLOTS - 1);
+		int h = heads[slot];
+		heads[slot] = -1;
+		while (h >= 0) {
+			int next = timers[h].next;
+			expired.push_back(timers[h].element);
+			inWheel--;
+			pending--;
+			release(h);
+			count++;
+			h = next;
+		}
+	}
+	return count;
+}
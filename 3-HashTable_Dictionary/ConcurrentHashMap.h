@@ -0,0 +1,189 @@
+#pragma once
+
+#include<mutex>
+#include<new>
+#include "HashMap.h"
+using namespace std;
+
+// A HashMap that many threads can use at once, split into shards that each have their own HashMap and mutex
+// (lock striping).  A key is hashed once; bits 48 and up of the hash pick its shard and the shard's HashMap
+// uses the same hash for its probes, which take bits 0 to 47.  Only that shard is locked for the operation,
+// so threads working on different shards never wait for each other.  Each shard is aligned to its own cache
+// lines, so locking one does not slow down threads using a neighbour.
+//
+// numStored locks the shards one at a time, so it sees each one at a different moment; getKeys holds all of
+// them while it copies.  Values are returned by copy; there is no findOrInsert, since a reference would outlive
+// the lock.
+
+template <class K, class V, class Hash = typename DefaultHash<K>::type, class Eq = typename DefaultEq<K>::type>
+class ConcurrentHashMap {
+ public:
+	// Insert a (key,value) pair.  Returns false, leaving the table unchanged, if key is already in it.
+	bool insert(const K& key, const V& value);
+
+	// Remove key.  Returns false if key not in table.
+	template <class Q> bool remove(const Q& key);
+
+	// Lookup a key.  Copies value to value if found and returns true, returns false if key not in table.
+	template <class Q> bool lookup(const Q& key, V& value);
+
+	// Add delta to key's value, inserting (key,delta) if key is not in table.  Returns the new value.
+	template <class Q> V increment(const Q& key, const V& delta);
+
+	// Set key's value to value, inserting (key,value) if key is not in table.  Returns true if it was inserted.
+	template <class Q> bool insertOrAssign(const Q& key, const V& value);
+
+	// Return an array of all the keys in the table.  Stores these nkeys in array keys.
+	void getKeys(K*& all_keys, int& nkeys);
+
+	// Return the number of (key,value) pairs currently in the table.
+	int numStored();
+
+	// Return the number of shards.
+	int numShards() { return nshards; }
+
+	// Create a table that can store nkeys keys before its shards grow, split into nshards shards (rounded up to a
+	// power of 2).  One shard makes it a HashMap behind a single lock.
+	ConcurrentHashMap(int nkeys = 10000, int nshards = 256);
+	~ConcurrentHashMap();
+
+	ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+ private:
+	struct alignas(64) Shard {
+		mutex lock;
+		HashMap<K, V, Hash, Eq> map;
+		Shard(int nkeys) : map(nkeys) {}
+	};
+
+	static const int shard_shift = 48;
+
+	int nshards;  // a power of 2, at most 2^16
+	Shard *shards;
+	Hash hasher;
+
+	Shard& shardOf(unsigned long long hval) { return shards[(hval >> shard_shift) & (nshards - 1)]; }
+};
+
+
+template <class K, class V, class Hash, class Eq>
+ConcurrentHashMap<K, V, Hash, Eq>::ConcurrentHashMap(int nkeys, int nshardsi)
+{
+	nshards = 1;
+	while (nshards < nshardsi && nshards < (1 << (64 - shard_shift))) { nshards *= 2; }
+
+	// new[] can only default construct, so the shards are built in raw, suitably aligned memory.
+	shards = static_cast<Shard*>(::operator new[](nshards * sizeof(Shard), align_val_t(alignof(Shard))));
+	for (int i = 0; i < nshards; i++) { new (&shards[i]) Shard(nkeys / nshards + 1); }
+}
+
+template <class K, class V, class Hash, class Eq>
+ConcurrentHashMap<K, V, Hash, Eq>::~ConcurrentHashMap()
+{
+	for (int i = 0; i < nshards; i++) { shards[i].~Shard(); }
+	::operator delete[](shards, align_val_t(alignof(Shard)));
+}
+
+template <class K, class V, class Hash, class Eq>
+bool ConcurrentHashMap<K, V, Hash, Eq>::insert(const K& key, const V& value)
+{
+	unsigned long long hval = hasher(key);
+	Shard& s = shardOf(hval);
+	lock_guard<mutex> guard(s.lock);
+
+	bool inserted;
+	int i = s.map.upsert(key, hval, inserted);
+	if (inserted) { s.map.values[i] = value; }
+	return inserted;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool ConcurrentHashMap<K, V, Hash, Eq>::remove(const Q& key)
+{
+	unsigned long long hval = hasher(key);
+	Shard& s = shardOf(hval);
+	lock_guard<mutex> guard(s.lock);
+
+	int i = s.map.findSlot(key, hval);
+	if (i < 0) { return false; }
+	s.map.erase(i);
+	return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool ConcurrentHashMap<K, V, Hash, Eq>::lookup(const Q& key, V& value)
+{
+	unsigned long long hval = hasher(key);
+	Shard& s = shardOf(hval);
+	lock_guard<mutex> guard(s.lock);
+
+	int i = s.map.findSlot(key, hval);
+	if (i < 0) { return false; }
+	value = s.map.values[i];
+	return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+V ConcurrentHashMap<K, V, Hash, Eq>::increment(const Q& key, const V& delta)
+{
+	unsigned long long hval = hasher(key);
+	Shard& s = shardOf(hval);
+	lock_guard<mutex> guard(s.lock);
+
+	bool inserted;
+	int i = s.map.upsert(key, hval, inserted);
+	s.map.values[i] += delta;
+	return s.map.values[i];
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool ConcurrentHashMap<K, V, Hash, Eq>::insertOrAssign(const Q& key, const V& value)
+{
+	unsigned long long hval = hasher(key);
+	Shard& s = shardOf(hval);
+	lock_guard<mutex> guard(s.lock);
+
+	bool inserted;
+	int i = s.map.upsert(key, hval, inserted);
+	s.map.values[i] = value;
+	return inserted;
+}
+
+template <class K, class V, class Hash, class Eq>
+int ConcurrentHashMap<K, V, Hash, Eq>::numStored()
+{
+	int n = 0;
+	for (int i = 0; i < nshards; i++) {
+		lock_guard<mutex> guard(shards[i].lock);
+		n += shards[i].map.numStored();
+	}
+	return n;
+}
+
+// Locks every shard, in order, for the whole copy so the count and the keys agree.
+// PRE: n/a
+// POST: all_keys holds the nkeys keys in the table
+template <class K, class V, class Hash, class Eq>
+void ConcurrentHashMap<K, V, Hash, Eq>::getKeys(K*& all_keys, int& nkeys)
+{
+	for (int i = 0; i < nshards; i++) { shards[i].lock.lock(); }
+
+	nkeys = 0;
+	for (int i = 0; i < nshards; i++) { nkeys += shards[i].map.numStored(); }
+	all_keys = new K[nkeys];
+
+	int key_i = 0;
+	for (int i = 0; i < nshards; i++) {
+		HashMap<K, V, Hash, Eq>& map = shards[i].map;
+		for (int j = 0; j < map.tsize; j++) {
+			if (map.ctrl[j] >= 0) { all_keys[key_i++] = map.keys[j]; }
+		}
+	}
+
+	for (int i = nshards - 1; i >= 0; i--) { shards[i].lock.unlock(); }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstring>
+#include <cstddef>
+
+// String hash functions shared by the hash tables and hash_quality.
+//
+// djb2 reads a byte at a time and its low bits depend mostly on the last few characters.  wordHash is in the
+// style of wyhash: it reads 8 bytes at a time (two 4-byte reads for keys of 4 to 16 bytes, which covers nearly
+// every English word) and mixes with 64x64->128 bit multiplies folded back to 64 bits, so every output bit
+// depends on every input bit and any slice of it can be used as a table index.
+
+// 64-bit djb2, hash * 33 + c for each character.
+inline unsigned long long djb2(const char* s, size_t n) {
+	unsigned long long hash = 5381;
+	for (size_t i = 0; i < n; i++) { hash = ((hash << 5) + hash) + static_cast<unsigned char>(s[i]); }
+	return hash;
+}
+
+// Multiplies a and b and xors the two halves of the 128-bit product.
+inline unsigned long long hashMum(unsigned long long a, unsigned long long b) {
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+	return static_cast<unsigned long long>(r >> 64) ^ static_cast<unsigned long long>(r);
+#else
+	unsigned long long ha = a >> 32, hb = b >> 32, la = static_cast<unsigned int>(a), lb = static_cast<unsigned int>(b);
+	unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	unsigned long long t = rl + (rm0 << 32);
+	unsigned long long c = t < rl;
+	unsigned long long lo = t + (rm1 << 32);
+	c += lo < t;
+	unsigned long long hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	return hi ^ lo;
+#endif
+}
+
+inline unsigned long long hashRead64(const char* p) {
+	unsigned long long v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+inline unsigned long long hashRead32(const char* p) {
+	unsigned int v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+// Word-at-a-time 64-bit hash of the n bytes at s.
+inline unsigned long long wordHash(const char* s, size_t n) {
+	const unsigned long long p0 = 0xa0761d6478bd642fULL, p1 = 0xe7037ed1a0b428dbULL;
+	unsigned long long seed = p0;
+	unsigned long long a, b;
+
+	if (n <= 16) {
+		if (n >= 4) {
+			// The first and last 4 bytes, and the 4 at n/8*4 from each end: 4 reads that cover all n bytes.
+			size_t mid = (n >> 3) << 2;
+			a = (hashRead32(s) << 32) | hashRead32(s + mid);
+			b = (hashRead32(s + n - 4) << 32) | hashRead32(s + n - 4 - mid);
+		} else if (n > 0) {
+			a = (static_cast<unsigned long long>(static_cast<unsigned char>(s[0])) << 16)
+			    | (static_cast<unsigned long long>(static_cast<unsigned char>(s[n >> 1])) << 8)
+			    | static_cast<unsigned char>(s[n - 1]);
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		size_t i = n;
+		for (; i > 16; i -= 16, s += 16) {
+			seed = hashMum(hashRead64(s) ^ p1, hashRead64(s + 8) ^ seed);
+		}
+		// The last 16 bytes, overlapping the last block if n is not a multiple of 16.
+		a = hashRead64(s + i - 16);
+		b = hashRead64(s + i - 8);
+	}
+	return hashMum(p1 ^ n, hashMum(a ^ p1, b ^ seed));
+}
@@ -0,0 +1,505 @@
+#pragma once
+
+#include<iostream>
+#include<iomanip>
+#include<sstream>
+#include<string>
+#include<string_view>
+#include<functional>
+#include<utility>
+#include "Hash.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// A hash table mapping keys of type K to values of type V, laid out after the Swiss tables of Abseil: 1-byte
+// control bytes (empty, deleted, or 7 bits of the hash) probed 16 at a time next to arrays of keys and values.
+// Keys are unique except for pairs added with insertDuplicate.  SwissTable is the string to int table with
+// HashTable's interface built on this one.
+//
+// Hash and Eq default to StringHash and StringEq for string keys, and to std::hash mixed by wordHash's
+// multiply and std::equal_to otherwise.  The lookup functions are templates over the type of the key passed in:
+// with the string defaults a string_view or a const char* is hashed and compared as it is, and a string key is
+// only constructed when findOrInsert, increment or insertOrAssign adds a new pair.  Custom Hash and Eq work the
+// same way if they accept the types they are called with.
+//
+// PRE for all: K and V are default constructible and movable, K is constructible from the key types passed to
+// the inserting functions.
+
+// Hashes anything that converts to a string_view with wordHash.
+struct StringHash {
+	unsigned long long operator()(string_view s) const { return wordHash(s.data(), s.size()); }
+};
+
+// Compares anything that converts to a string_view.
+struct StringEq {
+	bool operator()(string_view a, string_view b) const { return a == b; }
+};
+
+// std::hash, which is the identity for integers on common libraries, followed by a multiply so every bit of the
+// result depends on every bit of the key.
+template <class K>
+struct MixedHash {
+	unsigned long long operator()(const K& key) const {
+		return hashMum(static_cast<unsigned long long>(std::hash<K>()(key)) ^ 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL);
+	}
+};
+
+template <class K> struct DefaultHash { typedef MixedHash<K> type; };
+template <> struct DefaultHash<string> { typedef StringHash type; };
+template <class K> struct DefaultEq { typedef equal_to<K> type; };
+template <> struct DefaultEq<string> { typedef StringEq type; };
+
+
+template <class K, class V, class Hash = typename DefaultHash<K>::type, class Eq = typename DefaultEq<K>::type>
+class HashMap {
+ public:
+	// Insert a (key,value) pair.  Returns false, leaving the table unchanged, if key is already in it.
+	bool insert(const K& key, const V& value);
+
+	// Insert a (key,value) pair even if key is already in the table, for tables that hold duplicate keys.  The
+	// other functions find whichever pair with key comes first on its probe sequence.
+	void insertDuplicate(const K& key, const V& value);
+
+	// Remove a pair holding both key and value, for tables that hold duplicate keys.  Returns false if there is
+	// none.  PRE: V is equality comparable.
+	bool removePair(const K& key, const V& value);
+
+	// Remove key.  Returns false if key not in table.
+	template <class Q> bool remove(const Q& key);
+
+	// Lookup a key.  Copies value to value if found and returns true, returns false if key not in table.
+	template <class Q> bool lookup(const Q& key, V& value);
+
+	// Pointer to key's value, nullptr if key not in table.  Good until the next insert or remove.
+	template <class Q> V* find(const Q& key);
+
+	// Modify key's value.  Returns false if key not in table.
+	template <class Q> bool modify(const Q& key, const V& value);
+
+	// Return a reference to key's value, inserting (key,V()) first if key is not in table.  The reference is good
+	// until the next insert or remove.  Hashes key once and probes once.
+	template <class Q> V& findOrInsert(const Q& key);
+
+	// Add delta to key's value, inserting (key,delta) if key is not in table.  Returns the new value.
+	template <class Q> V increment(const Q& key, const V& delta);
+
+	// Set key's value to value, inserting (key,value) if key is not in table.  Returns true if it was inserted.
+	template <class Q> bool insertOrAssign(const Q& key, const V& value);
+
+	// Return an array of all the keys in the table.  Stores these nkeys in array keys.
+	void getKeys(K*& all_keys, int& nkeys);
+
+	// Return the number of (key,value) pairs currently in the table.
+	int numStored() { return nstored; }
+
+	// Return the number of slots in the table.
+	int capacity() { return tsize; }
+
+	// Print every slot with its key, value and control byte.  PRE: K and V can be written to an ostream.
+	void printTable();
+
+	// Create a default sized hash table.
+	HashMap() { init(default_size); }
+
+	// Create a hash table that can store nkeys keys before it grows.
+	HashMap(int nkeys) { init(nkeys); }
+	~HashMap();
+
+	HashMap(const HashMap&) = delete;
+	HashMap& operator=(const HashMap&) = delete;
+
+ private:
+	static const int group_size = 16;
+	static const signed char ctrl_empty = -128;
+	static const signed char ctrl_deleted = -2;
+	static const int default_size = 10000;  // Default number of keys.
+
+	int tsize;  // number of slots, a power of 2 and a multiple of group_size
+	int nstored;
+	int nused;  // number of slots that are full or deleted
+	signed char *ctrl;
+	K *keys;
+	V *values;
+	Hash hasher;
+	Eq equal;
+
+	void init(int nkeys);
+	unsigned int matchByte(int g, signed char b);
+	unsigned int matchFree(int g);
+
+	// Slot holding key, -1 if there is none.
+	template <class Q> int findSlot(const Q& key, unsigned long long hval);
+	// First full slot on hval's probe sequence whose 7 hash bits match and for which match(slot) is true, -1 if
+	// there is none.
+	template <class Match> int findSlotIf(unsigned long long hval, Match match);
+	// Slot for key, placing K(key) in the first free slot of its probe sequence if it is not in the table.
+	template <class Q> int upsert(const Q& key, unsigned long long hval, bool& inserted);
+	// Empties full slot i.
+	void erase(int i);
+	// Grows or rebuilds the table if it has no room for one more pair, returns true if it did.
+	bool makeRoom();
+	void rehash(int new_size);
+	// Puts the pair in the first empty or deleted slot on hval's probe sequence, returns the slot.
+	int place(K&& key, V&& value, unsigned long long hval);
+
+	// Hashes a key once to pick a shard and then calls the functions above with the hash.
+	template <class, class, class, class> friend class ConcurrentHashMap;
+};
+
+
+template <class K, class V, class Hash, class Eq>
+bool HashMap<K, V, Hash, Eq>::insert(const K& key, const V& value)
+{
+	bool inserted;
+	int i = upsert(key, hasher(key), inserted);
+	if (inserted) { values[i] = value; }
+	return inserted;
+}
+
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::insertDuplicate(const K& key, const V& value)
+{
+	unsigned long long hval = hasher(key);
+	makeRoom();
+	place(K(key), V(value), hval);
+	nstored++;
+}
+
+template <class K, class V, class Hash, class Eq>
+bool HashMap<K, V, Hash, Eq>::removePair(const K& key, const V& value)
+{
+	int i = findSlotIf(hasher(key), [&](int j) { return equal(keys[j], key) && values[j] == value; });
+	if (i < 0) { return false; }
+
+	erase(i);
+	return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool HashMap<K, V, Hash, Eq>::remove(const Q& key)
+{
+	int i = findSlot(key, hasher(key));
+	if (i < 0) { return false; }
+
+	erase(i);
+	return true;
+}
+
+// A slot goes back to empty if its group still has an empty slot: a group with an empty slot ends every probe
+// sequence that reaches it, so it has never been full since the last rebuild and no pair was placed past it.
+// PRE: slot i is full
+// POST: the pair in slot i is gone
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::erase(int i)
+{
+	if (matchByte(i & ~(group_size - 1), ctrl_empty) != 0) {
+		ctrl[i] = ctrl_empty;
+		nused--;
+	}
+	else { ctrl[i] = ctrl_deleted; }
+	keys[i] = K();
+	values[i] = V();
+	nstored--;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool HashMap<K, V, Hash, Eq>::lookup(const Q& key, V& value)
+{
+	int i = findSlot(key, hasher(key));
+	if (i < 0) { return false; }
+
+	value = values[i];
+	return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+V* HashMap<K, V, Hash, Eq>::find(const Q& key)
+{
+	int i = findSlot(key, hasher(key));
+	return (i < 0) ? nullptr : &values[i];
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool HashMap<K, V, Hash, Eq>::modify(const Q& key, const V& value)
+{
+	int i = findSlot(key, hasher(key));
+	if (i < 0) { return false; }
+
+	values[i] = value;
+	return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+V& HashMap<K, V, Hash, Eq>::findOrInsert(const Q& key)
+{
+	bool inserted;
+	int i = upsert(key, hasher(key), inserted);  // before reading values, which a rehash replaces
+	return values[i];
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+V HashMap<K, V, Hash, Eq>::increment(const Q& key, const V& delta)
+{
+	V& value = findOrInsert(key);
+	value += delta;
+	return value;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+bool HashMap<K, V, Hash, Eq>::insertOrAssign(const Q& key, const V& value)
+{
+	bool inserted;
+	int i = upsert(key, hasher(key), inserted);
+	values[i] = value;
+	return inserted;
+}
+
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::getKeys(K*& all_keys, int& nkeys)
+{
+	all_keys = new K[nstored];
+	nkeys = nstored;
+
+	int key_i = 0;
+	for (int i = 0; i < tsize && key_i < nkeys; i++) {
+		if (ctrl[i] >= 0) { all_keys[key_i++] = keys[i]; }
+	}
+}
+
+// Prints actual data structure contents, entry might not be "in" the table if its control byte is not full.
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::printTable()
+{
+	const int indw = 5;
+	int long_string = 3; // Length of "Key", nice magic number.
+	const int intw = 10;
+	const int ctrlw = 7;
+	for (int i=0; i<tsize; i++) {
+		ostringstream key;
+		key << keys[i];
+		if (static_cast<int>(key.str().length()) > long_string)
+			long_string = static_cast<int>(key.str().length());
+	}
+
+	// Print title
+	cout << setw(indw) << left << "Index" << " | " << setw(long_string) << left << "Key" << " | " << setw(intw) << "Value" << " | " << "Control" << endl;
+
+	// Print a separator.
+	for (int i=0; i < indw+long_string+intw+ctrlw+9; i++) {
+		cout << "-";
+	}
+	cout << endl;
+
+	// Print each table row, control bytes as numbers: -128 empty, -2 deleted, 0..127 full.
+	for (int i=0; i<tsize; i++) {
+		cout << setw(indw) << left << i << " | " << setw(long_string) << left << keys[i] << " | " << setw(intw) << values[i] << " | " << static_cast<int>(ctrl[i]) << endl;
+	}
+
+	// Print a separator.
+	for (int i=0; i < indw+long_string+intw+ctrlw+9; i++) {
+		cout << "-";
+	}
+	cout << endl;
+}
+
+template <class K, class V, class Hash, class Eq>
+HashMap<K, V, Hash, Eq>::~HashMap()
+{
+	delete[] ctrl;
+	delete[] keys;
+	delete[] values;
+}
+
+// PRE: n/a
+// POST: an empty table with the smallest power of 2 slots, at least group_size, that nkeys fill to at most 7/8
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::init(int nkeys)
+{
+	tsize = group_size;
+	while (7LL * tsize < 8LL * nkeys) { tsize *= 2; }
+	nstored = 0;
+	nused = 0;
+
+	ctrl = new signed char[tsize];
+	keys = new K[tsize];
+	values = new V[tsize];
+	for (int i = 0; i < tsize; i++) { ctrl[i] = ctrl_empty; }
+}
+
+template <class K, class V, class Hash, class Eq>
+unsigned int HashMap<K, V, Hash, Eq>::matchByte(int g, signed char b)
+{
+#ifdef __SSE2__
+	__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + g));
+	return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(b))));
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < group_size; i++) {
+		if (ctrl[g + i] == b) { mask |= 1u << i; }
+	}
+	return mask;
+#endif
+}
+
+template <class K, class V, class Hash, class Eq>
+unsigned int HashMap<K, V, Hash, Eq>::matchFree(int g)
+{
+#ifdef __SSE2__
+	__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + g));
+	return static_cast<unsigned int>(_mm_movemask_epi8(group));
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < group_size; i++) {
+		if (ctrl[g + i] < 0) { mask |= 1u << i; }
+	}
+	return mask;
+#endif
+}
+
+// PRE: hval is hasher(key)
+// POST: returns the slot holding key, -1 if there is none
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+int HashMap<K, V, Hash, Eq>::findSlot(const Q& key, unsigned long long hval)
+{
+	return findSlotIf(hval, [&](int i) { return equal(keys[i], key); });
+}
+
+// The high bits of hval pick the first group and the low 7 are compared with the control bytes.  Groups are
+// probed at triangular offsets 0, 1, 3, 6, ..., which visit every group when their number is a power of 2.
+// PRE: n/a
+// POST: returns the first matching slot, -1 if there is none
+template <class K, class V, class Hash, class Eq>
+template <class Match>
+int HashMap<K, V, Hash, Eq>::findSlotIf(unsigned long long hval, Match match)
+{
+	signed char h2 = static_cast<signed char>(hval & 0x7F);
+	int gmask = tsize / group_size - 1;
+
+	int gi = static_cast<int>(hval >> 7) & gmask;
+	for (int iter = 1; iter <= gmask + 1; iter++) {
+		int g = gi * group_size;
+		for (unsigned int m = matchByte(g, h2); m != 0; m &= m - 1) {
+			int i = g + __builtin_ctz(m);
+			if (match(i)) { return i; }
+		}
+		if (matchByte(g, ctrl_empty) != 0) { return -1; }
+		gi = (gi + iter) & gmask;
+	}
+	return -1;
+}
+
+// Walks key's probe sequence once, noting the first free slot on the way, and places key there if the sequence
+// ends without finding it.  Only if the table has to grow first is the sequence walked again, in the new arrays.
+// PRE: hval is hasher(key)
+// POST: returns the slot holding key, sets inserted to whether (K(key),V()) was just placed there
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+int HashMap<K, V, Hash, Eq>::upsert(const Q& key, unsigned long long hval, bool& inserted)
+{
+	signed char h2 = static_cast<signed char>(hval & 0x7F);
+	int gmask = tsize / group_size - 1;
+
+	int free_slot = -1;
+	int gi = static_cast<int>(hval >> 7) & gmask;
+	for (int iter = 1; iter <= gmask + 1; iter++) {
+		int g = gi * group_size;
+		for (unsigned int m = matchByte(g, h2); m != 0; m &= m - 1) {
+			int i = g + __builtin_ctz(m);
+			if (equal(keys[i], key)) {
+				inserted = false;
+				return i;
+			}
+		}
+		unsigned int free_mask = matchFree(g);
+		if (free_slot < 0 && free_mask != 0) { free_slot = g + __builtin_ctz(free_mask); }
+		if (matchByte(g, ctrl_empty) != 0) { break; }
+		gi = (gi + iter) & gmask;
+	}
+
+	inserted = true;
+	bool rebuilt = makeRoom();
+	nstored++;
+	if (rebuilt) { return place(K(key), V(), hval); }
+
+	if (ctrl[free_slot] == ctrl_empty) { nused++; }
+	ctrl[free_slot] = h2;
+	keys[free_slot] = K(key);
+	values[free_slot] = V();
+	return free_slot;
+}
+
+// Grow before the groups fill up: deleted slots count too, since probes walk over them.  Double if the pairs
+// would fill more than half of the allowed 7/8, otherwise rebuilding at the same size is enough to clear out the
+// deleted slots.
+// PRE: n/a
+// POST: returns true if the table was rebuilt, there is an empty slot for one more pair either way
+template <class K, class V, class Hash, class Eq>
+bool HashMap<K, V, Hash, Eq>::makeRoom()
+{
+	if (8 * (nused + 1) <= 7 * tsize) { return false; }
+
+	rehash(16 * (nstored + 1) > 7 * tsize ? 2 * tsize : tsize);
+	return true;
+}
+
+// PRE: new_size is a power of 2, at least group_size, with room for nstored pairs
+// POST: the full slots are moved into new arrays with no deleted slots
+template <class K, class V, class Hash, class Eq>
+void HashMap<K, V, Hash, Eq>::rehash(int new_size)
+{
+	int old_tsize = tsize;
+	signed char *old_ctrl = ctrl;
+	K *old_keys = keys;
+	V *old_values = values;
+
+	tsize = new_size;
+	nused = 0;
+	ctrl = new signed char[tsize];
+	keys = new K[tsize];
+	values = new V[tsize];
+	for (int i = 0; i < tsize; i++) { ctrl[i] = ctrl_empty; }
+
+	for (int i = 0; i < old_tsize; i++) {
+		if (old_ctrl[i] >= 0) {
+			unsigned long long hval = hasher(old_keys[i]);
+			place(std::move(old_keys[i]), std::move(old_values[i]), hval);
+		}
+	}
+
+	delete[] old_ctrl;
+	delete[] old_keys;
+	delete[] old_values;
+}
+
+// PRE: the table has an empty or deleted slot
+// POST: the pair is in the first free slot on hval's probe sequence, counted in nused if it was empty
+template <class K, class V, class Hash, class Eq>
+int HashMap<K, V, Hash, Eq>::place(K&& key, V&& value, unsigned long long hval)
+{
+	int gmask = tsize / group_size - 1;
+
+	int gi = static_cast<int>(hval >> 7) & gmask;
+	for (int iter = 1; ; iter++) {
+		int g = gi * group_size;
+		unsigned int m = matchFree(g);
+		if (m != 0) {
+			int i = g + __builtin_ctz(m);
+			if (ctrl[i] == ctrl_empty) { nused++; }
+			ctrl[i] = static_cast<signed char>(hval & 0x7F);
+			keys[i] = std::move(key);
+			values[i] = std::move(value);
+			return i;
+		}
+		gi = (gi + iter) & gmask;
+	}
+}
@@ -3,46 +3,71 @@
 #include <iomanip>      // std::setw
 #include <cmath>
 #include <string>
+#include <algorithm>   // std::min
+#include <utility>     // std::move
 #include "HashTable.h"
+#include "Hash.h"
 using namespace std;
 
 bool HashTable::insert(const string& key, int value) {
-	// Try to insert key,value pair at pval, increment by probe function.
-	int hval = hash(key);
-	int pval = hval;
-
-	for (int iter=0; iter<tsize; iter++) {
-		if (sentinels[pval] != curr_used) {
-			// Found an empty spot, insert the (key,value) pair here.
-			sentinels[pval] = curr_used;
-			keys[pval] = key;
-			values[pval] = value;
-			nstored++;
-			return true;
-		}
-		pval = probeFunction(hval,iter);
+	migrate(rehash_step);
+	makeRoom();
+
+	if (robin_hood) { placeRobinHood(key, value, hash(key), 0); }
+	else {
+		int pval = freeSlot(hash(key));
+		sentinels[pval] = curr_used;
+		keys[pval] = key;
+		values[pval] = value;
 	}
-	return false;
+	nstored++;
+	return true;
+}
+
+// PRE: n/a
+// POST: returns a reference to key's value, inserting key with value 0 if it is not in the table
+int& HashTable::findOrInsert(const string& key) {
+	bool inserted;
+	int i = upsert(key, inserted);  // before reading values, which upsert may reallocate
+	return values[i];
 }
 
+
+// PRE: n/a
+// POST: adds delta to key's value, inserting key with value delta if it is not in the table, returns the new value
+int HashTable::increment(const string& key, int delta) {
+	int& value = findOrInsert(key);
+	value += delta;
+	return value;
+}
+
+
+// PRE: n/a
+// POST: key's value is value, returns true if key was inserted and false if it was already in the table
+bool HashTable::insertOrAssign(const string& key, int value) {
+	bool inserted;
+	int i = upsert(key, inserted);
+	values[i] = value;
+	return inserted;
+}
+
+
 // looks for key/value in hash table. if it exists and is still in use (sentinel == 1), set sentinel to -1 (this "removes" it)
 // PRE: key/value pair must exist in hash table
 // POST: removes key/value pair if it exists in hash table and is in use
 bool HashTable::remove(const string& key, int value) {
-	int hashKey = hash(key);
-
-	for (int i = 0; i < tsize; i++) {
-		int trythiskey = probeFunction(hashKey, i);
-
-		if (sentinels[trythiskey] == 0) { return false; }
-		else if (sentinels[trythiskey] == 1) { 
-			if (keys[trythiskey] == key && values[trythiskey] == value) {
-				sentinels[trythiskey] = -1;
-				return true;
-			}
-		}
-	}
-	return false;
+	migrate(rehash_step);
+
+	bool in_old;
+	int i = find(key, &value, in_old);
+	if (i < 0) { return false; }
+
+	// The old arrays are only read from, so a tombstone there is fine in Robin Hood mode too.
+	if (in_old) { old_sentinels[i] = prev_used; }
+	else if (robin_hood) { shiftBack(i); }
+	else { sentinels[i] = prev_used; }
+	nstored--;
+	return true;
 }
 
 
@@ -50,20 +75,14 @@ bool HashTable::remove(const string& key, int value) {
 // PRE: key must exist in hash table
 // POST: modifies the value of the variable passed in as an argument
 bool HashTable::lookup(const string& key, int& value) {
-	int hashKey = hash(key);
+	migrate(rehash_step);
 
-	for (int i = 0; i < tsize; i++) {
-		int trythiskey = probeFunction(hashKey, i);
+	bool in_old;
+	int i = find(key, nullptr, in_old);
+	if (i < 0) { return false; }
 
-		if (sentinels[trythiskey] == 0) { return false; }
-		else if (sentinels[trythiskey] == 1) {
-			if (keys[trythiskey] == key) {
-				value = values[trythiskey];
-				return true;
-			}
-		}
-	}
-	return false;
+	value = in_old ? old_values[i] : values[i];
+	return true;
 }
 
 
@@ -71,20 +90,280 @@ bool HashTable::lookup(const string& key, int& value) {
 // PRE: key must exist in hash table
 // POST: modifies the value of the key pair in the hash table to the value that was passed in as an argument
 bool HashTable::modify(const string& key, int value) {
-	int hashKey = hash(key);
+	migrate(rehash_step);
 
-	for (int i = 0; i < tsize; i++) {
-		int trythiskey = probeFunction(hashKey, i);
+	bool in_old;
+	int i = find(key, nullptr, in_old);
+	if (i < 0) { return false; }
 
-		if (sentinels[trythiskey] == 0) { return false; }
-		else if (sentinels[trythiskey] == 1) {
-			if (keys[trythiskey] == key) {
-				values[trythiskey] = value;
-				return true;
+	if (in_old) { old_values[i] = value; }
+	else { values[i] = value; }
+	return true;
+}
+
+
+// walks the probe sequence of hval in one set of arrays until a never used slot ends it
+// PRE: size is a power of 2
+// POST: returns the index of the first slot in use with key (and *value, if value is not nullptr), -1 if there is none
+int HashTable::findIn(const string& key, const int* value, unsigned int hval, string* ks, int* vs, int* sent, int* dist, int size) {
+	for (int i = 0; i < size; i++) {
+		int trythiskey = probeFunction(hval, i, size);
+
+		if (sent[trythiskey] == never_used) { return -1; }
+		else if (sent[trythiskey] == curr_used) {
+			// A pair closer to its home than i would have been displaced by key on insert.
+			if (dist != nullptr && dist[trythiskey] < i) { return -1; }
+			if (ks[trythiskey] == key && (value == nullptr || vs[trythiskey] == *value)) {
+				return trythiskey;
 			}
 		}
 	}
-	return false;
+	return -1;
+}
+
+
+// hashes once and looks in the current arrays, then in the old ones while an incremental rehash is under way
+// PRE: n/a
+// POST: returns the slot index and sets in_old to say which arrays it is in, returns -1 if key is in neither
+int HashTable::find(const string& key, const int* value, bool& in_old) {
+	unsigned int hval = hash(key);
+
+	in_old = false;
+	int i = findIn(key, value, hval, keys, values, sentinels, dists, tsize);
+	if (i >= 0 || old_keys == nullptr) { return i; }
+
+	in_old = true;
+	return findIn(key, value, hval, old_keys, old_values, old_sentinels, old_dists, old_tsize);
+}
+
+
+// Hashes once and walks key's probe sequence in the current arrays once, noting the first slot key could go in
+// on the way, so a key that is not there is placed without probing again.  Only when the table has to grow first
+// is the sequence walked again, in the new arrays.  A pair still in the old arrays of an incremental rehash is
+// moved over the same way, so the slot returned is never one the rehash is about to free.
+// PRE: n/a
+// POST: returns the slot of the current arrays holding key, inserted with value 0 if it was not in the table, in
+// which case inserted is true
+int HashTable::upsert(const string& key, bool& inserted) {
+	migrate(rehash_step);
+	unsigned int hval = hash(key);
+
+	inserted = true;
+	int free_iter = -1;  // first probe iteration reaching a slot key can be placed in
+	int iter = 0;
+	for (; iter < tsize; iter++) {
+		int pval = probeFunction(hval, iter, tsize);
+		if (sentinels[pval] == never_used) { break; }
+		if (sentinels[pval] == prev_used) {
+			if (free_iter < 0) { free_iter = iter; }
+			continue;
+		}
+		if (robin_hood && dists[pval] < iter) { break; }
+		if (keys[pval] == key) {
+			inserted = false;
+			return pval;
+		}
+	}
+	if (free_iter < 0) { free_iter = iter; }
+
+	string old_key;
+	int value = 0;
+	if (old_keys != nullptr) {
+		int i = findIn(key, nullptr, hval, old_keys, old_values, old_sentinels, old_dists, old_tsize);
+		if (i >= 0) {
+			old_key = std::move(old_keys[i]);
+			value = old_values[i];
+			old_sentinels[i] = prev_used;  // taken out before makeRoom can finish the rehash and free it
+			inserted = false;
+		}
+	}
+
+	bool rebuilt = makeRoom();
+	if (inserted) { nstored++; }
+	if (robin_hood) {
+		if (inserted) { return placeRobinHood(key, value, hval, rebuilt ? 0 : free_iter); }
+		return placeRobinHood(std::move(old_key), value, hval, rebuilt ? 0 : free_iter);
+	}
+
+	int pval;
+	if (rebuilt) { pval = freeSlot(hval); }
+	else {
+		pval = probeFunction(hval, free_iter, tsize);
+		if (sentinels[pval] == never_used) { nused++; }
+	}
+	sentinels[pval] = curr_used;
+	if (inserted) { keys[pval] = key; }
+	else { keys[pval] = std::move(old_key); }
+	values[pval] = value;
+	return pval;
+}
+
+
+// Grow before probe chains get long: slots previously used count too, since probes walk over them.
+// Double if the pairs would fill more than half of the table, otherwise a rebuild at the same size is
+// enough to clear out the previously used slots.
+// PRE: n/a
+// POST: returns true if the current arrays changed, there is room for one more pair either way
+bool HashTable::makeRoom() {
+	if (4 * (nused + 1) <= 3 * tsize) { return false; }
+
+	migrate(old_tsize); // a rehash in progress has to finish first
+	if (4 * (nused + 1) > 3 * tsize) {
+		grow(2 * (nstored + 1) > tsize ? 2 * tsize : tsize);
+	}
+	return true;
+}
+
+
+// PRE: the current arrays have a slot that is not in use
+// POST: returns the first slot not in use on the probe sequence of hval, counted in nused if it was never used
+int HashTable::freeSlot(unsigned int hval) {
+	for (int iter = 0; ; iter++) {
+		int pval = probeFunction(hval, iter, tsize);
+		if (sentinels[pval] != curr_used) {
+			if (sentinels[pval] == never_used) { nused++; }
+			return pval;
+		}
+	}
+}
+
+
+// walks the probe sequence of hval from iteration start carrying the pair to place; whenever the carried pair is
+// further from home than the one in the slot, they swap and the displaced pair is carried on
+// PRE: robin_hood, the current arrays have a never used slot, the slots before iteration start are no place for the pair
+// POST: the pair is in the current arrays, every pair is still reachable from its home slot, nused counts the slot
+// filled, returns the slot the pair went in
+int HashTable::placeRobinHood(string key, int value, unsigned int hval, int start) {
+	int placed = -1;
+	int dist = start;
+	for (int iter = start; ; iter++, dist++) {
+		int pval = probeFunction(hval, iter, tsize);
+		if (sentinels[pval] == never_used) {
+			sentinels[pval] = curr_used;
+			keys[pval] = std::move(key);
+			values[pval] = value;
+			dists[pval] = dist;
+			nused++;
+			return (placed < 0) ? pval : placed;
+		}
+		if (dists[pval] < dist) {
+			if (placed < 0) { placed = pval; }
+			swap(keys[pval], key);
+			swap(values[pval], value);
+			swap(dists[pval], dist);
+		}
+	}
+}
+
+
+// backward-shift deletion: each following pair of the run moves into the slot before it, until a never used
+// slot or a pair already at its home ends the run
+// PRE: robin_hood, slot i of the current arrays is in use
+// POST: the pair in slot i is gone and the last slot of its run is never used again
+void HashTable::shiftBack(int i) {
+	for (;;) {
+		int next = probeFunction(i, 1, tsize);
+		if (sentinels[next] != curr_used || dists[next] == 0) { break; }
+
+		keys[i] = std::move(keys[next]);
+		values[i] = values[next];
+		dists[i] = dists[next] - 1;
+		i = next;
+	}
+	sentinels[i] = never_used;
+	nused--;
+}
+
+
+// moves the current arrays aside as the old ones and allocates new_size empty slots, then moves everything over
+// unless in incremental mode
+// PRE: no rehash is in progress, new_size is a power of 2 larger than nstored
+// POST: the pairs are in the new arrays, or on their way there
+void HashTable::grow(int new_size) {
+	old_tsize = tsize;
+	old_keys = keys;
+	old_values = values;
+	old_sentinels = sentinels;
+	old_dists = dists;
+	migrate_pos = 0;
+
+	tsize = new_size;
+	nused = 0;
+	keys = new string[tsize];
+	values = new int[tsize];
+	sentinels = new int[tsize];
+	dists = robin_hood ? new int[tsize] : nullptr;
+	for (int i=0; i<tsize; i++)
+		sentinels[i]=never_used;
+
+	if (!incremental) { migrate(old_tsize); }
+}
+
+
+// Moved slots become previously used rather than never used, so lookups of pairs still in the old arrays keep
+// probing past them.
+// PRE: n/a
+// POST: up to n more old slots are moved into the current arrays, the old arrays are freed once all are moved
+void HashTable::migrate(int n) {
+	if (old_keys == nullptr) { return; }
+
+	int end = min(old_tsize, migrate_pos + n);
+	for (; migrate_pos < end; migrate_pos++) {
+		if (old_sentinels[migrate_pos] != curr_used) { continue; }
+
+		unsigned int hval = hash(old_keys[migrate_pos]);
+		if (robin_hood) { placeRobinHood(std::move(old_keys[migrate_pos]), old_values[migrate_pos], hval, 0); }
+		else {
+			int pval = freeSlot(hval);
+			sentinels[pval] = curr_used;
+			keys[pval] = std::move(old_keys[migrate_pos]);
+			values[pval] = old_values[migrate_pos];
+		}
+		old_sentinels[migrate_pos] = prev_used;
+	}
+
+	if (migrate_pos >= old_tsize) { freeOld(); }
+}
+
+
+void HashTable::freeOld() {
+	delete[] old_keys;
+	delete[] old_values;
+	delete[] old_sentinels;
+	delete[] old_dists;
+	old_keys = nullptr;
+	old_values = nullptr;
+	old_sentinels = nullptr;
+	old_dists = nullptr;
+	old_tsize = 0;
+	migrate_pos = 0;
+}
+
+
+void HashTable::setIncrementalRehash(bool incr) {
+	incremental = incr;
+	if (!incremental) { migrate(old_tsize); }
+}
+
+
+bool HashTable::rehashing() {
+	return old_keys != nullptr;
+}
+
+
+// Pairs in the old arrays of an incremental rehash were placed with the old function, so this rebuilds in one go.
+// PRE: n/a
+// POST: every pair is placed by the hash function hf
+void HashTable::setHashFunction(HashFunction hf) {
+	migrate(old_tsize);
+	if (hf == hash_function) { return; }
+
+	hash_function = hf;
+	if (nstored == 0) { return; }
+	bool incr = incremental;
+	incremental = false;
+	grow(tsize);
+	incremental = incr;
 }
 
 
@@ -94,17 +373,24 @@ void HashTable::getKeys(string*& all_keys, int& nkeys) {
 	nkeys = nstored;
 
 
-	// Walk the table's array.
+	// Walk the table's arrays, the old ones too during an incremental rehash.
 	int key_i=0;
-	for (int i=0; i<tsize; i++) {
-		if (sentinels[i]==curr_used) {
-			// Debug check: there shouldn't be more sentinels at curr_used than nstored thinks.
-			if (key_i > nkeys) {
-				cerr << "Error: more keys in table than nstored reports." << endl;
+	for (int pass=0; pass<2; pass++) {
+		int n = (pass == 0) ? tsize : old_tsize;
+		string* ks = (pass == 0) ? keys : old_keys;
+		int* sent = (pass == 0) ? sentinels : old_sentinels;
+
+		for (int i=0; i<n; i++) {
+			if (sent[i]==curr_used) {
+				// Debug check: there shouldn't be more sentinels at curr_used than nstored thinks.
+				if (key_i >= nkeys) {
+					cerr << "Error: more keys in table than nstored reports." << endl;
+					return;
+				}
+
+				all_keys[key_i] = ks[i];
+				key_i++;
 			}
-
-			all_keys[key_i] = keys[i];
-			key_i++;
 		}
 	}
 }
@@ -114,53 +400,101 @@ int HashTable::numStored() {
 }
 
 
-int HashTable::hash(const string& key) {
-	return smarterHash(key);
+int HashTable::capacity() {
+	return tsize;
 }
 
 
-int HashTable::probeFunction(int val, int iter) {
-	// Linear probing.
-	return (val + iter) % tsize;
+// PRE: n/a
+// POST: returns 1 + the largest distance of a pair in use from its home slot, 0 for an empty table
+int HashTable::longestProbe() {
+	int longest = 0;
+	for (int i=0; i<tsize; i++) {
+		if (sentinels[i] == curr_used) {
+			int dist = (i - static_cast<int>(hash(keys[i]) & (tsize - 1))) & (tsize - 1);
+			longest = max(longest, dist + 1);
+		}
+	}
+	return longest;
 }
 
 
-int HashTable::sillyHash(const string& key) {
+unsigned int HashTable::hash(const string& key) {
+	if (hash_function == DJB2) { return smarterHash(key); }
+	return wordAtATimeHash(key);
+}
+
+
+int HashTable::probeFunction(unsigned int val, int iter, int size) {
+	// Linear probing, size is a power of 2 so the mask is a cheap modulo.
+	return (val + iter) & (size - 1);
+}
+
+
+unsigned int HashTable::sillyHash(const string& key) {
 	return tsize/2;
 }
 
 // djb2 implementation for strings, less collisions than horner's method in tests i ran, and fast
 // PRE: key is non empty
-// POST: return hash value modded with tsize
-int HashTable::smarterHash(const string& key) {
+// POST: return hash value, probeFunction() reduces it to a slot
+unsigned int HashTable::smarterHash(const string& key) {
 	unsigned long hash = 5381;
 	for (int i{ 0 }, c{ key[0] }; i < key.size(); c = key[++i]) { hash = ((hash << 5) + hash) + c; } // hash * 33 + c
 
-	return hash % tsize;
+	return static_cast<unsigned int>(hash);
+}
+
+
+// folds the 64-bit hash to the 32 bits the table works with, every bit of it is well mixed
+// PRE: n/a
+// POST: return hash value, probeFunction() reduces it to a slot
+unsigned int HashTable::wordAtATimeHash(const string& key) {
+	unsigned long long hash = wordHash(key.data(), key.size());
+	return static_cast<unsigned int>(hash ^ (hash >> 32));
 }
 
 
 HashTable::HashTable() {
-	init(default_size);
+	init(default_size, LINEAR);
 }
 
 
 HashTable::HashTable(int nkeys) {
-	init(4*nkeys);
+	init(4*nkeys, LINEAR);
 }
 
 
-void HashTable::init(int tsizei) {
-	tsize = tsizei;
+HashTable::HashTable(int nkeys, Probing probing) {
+	init(4*nkeys, probing);
+}
+
+
+void HashTable::init(int tsizei, Probing probing) {
+	// Round up to a power of 2.
+	tsize = 8;
+	while (tsize < tsizei) { tsize *= 2; }
 	nstored = 0;
+	nused = 0;
 
 	keys = new string[tsize];
 	values = new int[tsize];
 	sentinels = new int[tsize];
+	robin_hood = (probing == ROBIN_HOOD);
+	dists = robin_hood ? new int[tsize] : nullptr;
 
 	// Initialize all sentinels to 0.
 	for (int i=0; i<tsize; i++)
 		sentinels[i]=0;
+
+	old_tsize = 0;
+	old_keys = nullptr;
+	old_values = nullptr;
+	old_sentinels = nullptr;
+	old_dists = nullptr;
+	migrate_pos = 0;
+	incremental = false;
+	hash_function = WORD_AT_A_TIME;
 }
 
 
@@ -169,6 +503,8 @@ HashTable::~HashTable() {
 	delete[] keys;
 	delete[] values;
 	delete[] sentinels;
+	delete[] dists;
+	freeOld();
 }
 
 
@@ -188,7 +524,9 @@ void HashTable::printTable() {
 	}
 
 	// Print title
-	cout << setw(indw) << left << "Index" << " | " << setw(long_string) << left << "Key" << " | " << setw(intw) << "Value" << " | " << "Sentinel" << endl;
+	cout << setw(indw) << left << "Index" << " | " << setw(long_string) << left << "Key" << " | " << setw(intw) << "Value" << " | " << "Sentinel";
+	if (robin_hood) { cout << " | Dist"; }
+	cout << endl;
 
 	// Print a separator.
 	for (int i=0; i < indw+long_string+intw+sentw+9; i++) {
@@ -198,7 +536,9 @@ void HashTable::printTable() {
 
 	// Print each table row.
 	for (int i=0; i<tsize; i++) {
-		cout << setw(indw) << left << i << " | " << setw(long_string) << left << keys[i] << " | " << setw(intw) << values[i] << " | " << sentinels[i] << endl;
+		cout << setw(indw) << left << i << " | " << setw(long_string) << left << keys[i] << " | " << setw(intw) << values[i] << " | " << sentinels[i];
+		if (robin_hood && sentinels[i] == curr_used) { cout << " | " << dists[i]; }
+		cout << endl;
 	}
 
 	// Print a separator.
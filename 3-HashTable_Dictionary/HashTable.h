@@ -6,9 +6,32 @@ using namespace std;
 
 // A hash table class for mapping strings to ints.
 // Note, this could be templated to allow mapping anything to anything.
+//
+// The table grows by itself: when the slots in use or previously used pass 3/4 of the table, it is rebuilt
+// at twice the size, or at the same size if removals left it mostly tombstones. Sizes are powers of 2 so a
+// hash is reduced with a mask. The rebuild moves every pair at once by default; in incremental mode the old
+// arrays are kept and each later operation moves a few of their slots, so no single insert pays for the
+// whole rehash.
+//
+// Collisions are resolved by linear probing.  By default a removed pair leaves a tombstone (a previously used
+// slot) that lookups must walk over until the next rebuild.  In Robin Hood mode each slot also records how far
+// it is from its home slot; an insert takes the slot of any pair closer to home than itself and carries that
+// pair on, so a lookup can stop as soon as it has probed further than the pair in the slot it is looking at.
+// A remove then shifts the following pairs of the run back one slot instead of leaving a tombstone, which keeps
+// probe lengths bounded under insert/remove churn.
+//
+// A key is hashed once per operation and its probe sequence is walked from that one value.  The hash function
+// is djb2, a byte at a time, or by default a word-at-a-time hash in the style of wyhash (see Hash.h) whose low
+// bits, the ones the mask keeps, depend on the whole key.
 
 class HashTable {
  public:
+	// Collision resolution, chosen when the table is created.
+	enum Probing { LINEAR, ROBIN_HOOD };
+
+	// Hash functions to choose from.
+	enum HashFunction { DJB2, WORD_AT_A_TIME };
+
 	// Insert a (key,value) pair into hash table.  Returns true if successful, false if not.
 	bool insert(const string& key, int value);
 
@@ -20,44 +43,115 @@ class HashTable {
 	// Modify a (key,value) pair in hash table.  Changes value to value if found and returns true, returns false if key not in table.
 	bool modify(const string& key, int value);
 
+	// The following hash key once and walk its probe sequence once, whether or not key is in the table.
+	// Return a reference to key's value, inserting (key,0) first if key is not in table.  A pair still in the old
+	// arrays of an incremental rehash is moved to the new ones first.  The reference is good until the next insert
+	// or remove; in Robin Hood mode, where moving old pairs over on any call can displace others, only until the
+	// next call while rehashing().
+	int& findOrInsert(const string& key);
+
+	// Add delta to key's value, inserting (key,delta) if key is not in table.  Returns the new value.
+	int increment(const string& key, int delta);
+
+	// Set key's value to value, inserting (key,value) if key is not in table.  Returns true if it was inserted.
+	bool insertOrAssign(const string& key, int value);
+
 	// Return an array of all the keys in the table.  Stores these nkeys in array keys.
 	void getKeys(string*& all_keys, int& nkeys);
 
 	// Return the number of (key,value) pairs currently in the table.
 	int numStored();
 
+	// Return the number of slots in the table.
+	int capacity();
+
+	// Return the most slots a lookup of a stored key probes in the current arrays, useful for debugging.
+	int longestProbe();
+
+	// Choose between rebuilding all at once when the table grows (the default) and moving a few slots on each
+	// later operation.  Switching incremental rehash off finishes a rehash in progress.
+	void setIncrementalRehash(bool incremental);
+
+	// True while an incremental rehash still has pairs in the old arrays.
+	bool rehashing();
+
+	// Choose the hash function.  A table that is not empty is rebuilt at once with the new one.
+	void setHashFunction(HashFunction hf);
+
 	// Create a default sized hash table.
 	HashTable();
 
-	// Create a hash table that can store nkeys keys (allocates 4x space).
+	// Create a hash table that can store nkeys keys (allocates 4x space, rounded up to a power of 2).
 	HashTable(int nkeys);
+
+	// Create a hash table that can store nkeys keys, resolving collisions as probing says.
+	HashTable(int nkeys, Probing probing);
 	~HashTable();
 
 	// Print the contents of the hash table data structures, useful for debugging.
 	void printTable();
 
  private:
-	int tsize;  // size of hash table arrays
-	int nstored;  // number of keys stored in table
+	int tsize;  // size of hash table arrays, a power of 2
+	int nstored;  // number of keys stored in table, including those still in the old arrays
+	int nused;  // number of slots of the current arrays that are not never_used
 	string *keys;
 	int *values;
 	int *sentinels; // 0 if never used, 1 if currently used, -1 if previously used.
 	static const int curr_used = 1;
 	static const int never_used = 0;
 	static const int prev_used = -1;
+	bool robin_hood;
+	int *dists;  // Robin Hood mode: distance of each slot in use from its home slot, nullptr otherwise.
 
 	static const int default_size = 10000;  // Default size of hash table.
-
-
-	// Probing function, returns location to check on iteration iter starting from initial value val.
-	int probeFunction(int val, int iter);  
-	void init(int tsizei);
-
-
-	int hash(const string& key);
+	static const int rehash_step = 16;  // Old slots moved per operation in incremental mode.
+
+	// Arrays being emptied by an incremental rehash, nullptr when there is none.
+	int old_tsize;
+	string *old_keys;
+	int *old_values;
+	int *old_sentinels;
+	int *old_dists;
+	int migrate_pos;  // Old slots before this one have been moved.
+	bool incremental;
+	HashFunction hash_function;
+
+
+	// Probing function, returns location to check on iteration iter starting from initial value val, in arrays of the given size.
+	int probeFunction(unsigned int val, int iter, int size);
+	void init(int tsizei, Probing probing);
+
+	// Index of the first slot in use holding key, and value too if value is not nullptr, -1 if there is none.
+	// With dist, the probe distances of a Robin Hood table, the search stops at the first pair closer to home.
+	int findIn(const string& key, const int* value, unsigned int hval, string* ks, int* vs, int* sent, int* dist, int size);
+	// Index of the slot holding key in the current or old arrays; sets in_old to say which.
+	int find(const string& key, const int* value, bool& in_old);
+
+	// Slot of the current arrays holding key, inserted with value 0 if it was not in the table.  A pair found in
+	// the old arrays is moved over first.
+	int upsert(const string& key, bool& inserted);
+	// Grows or rebuilds the table if it has no room for one more pair, returns true if the current arrays changed.
+	bool makeRoom();
+	// First slot not in use on the probe sequence of hval in the current arrays, which must have one.
+	int freeSlot(unsigned int hval);
+	// Robin Hood insert into the current arrays, which must have a never used slot, starting at probe iteration
+	// start.  Returns the slot the pair went in.
+	int placeRobinHood(string key, int value, unsigned int hval, int start);
+	// Robin Hood remove: empties slot i of the current arrays by shifting the rest of its run back.
+	void shiftBack(int i);
+	// Rebuilds at the given size, or starts an incremental rehash to it.
+	void grow(int new_size);
+	// Moves up to n slots of the old arrays, freeing them once they are empty.
+	void migrate(int n);
+	void freeOld();
+
+
+	unsigned int hash(const string& key);
 	// A couple of hash functions to use.
-	int sillyHash(const string& key);
-	int smarterHash(const string& key);
+	unsigned int sillyHash(const string& key);
+	unsigned int smarterHash(const string& key);
+	unsigned int wordAtATimeHash(const string& key);
 
 
-};
\ No newline at end of file
+};
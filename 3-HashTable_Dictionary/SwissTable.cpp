@@ -0,0 +1,64 @@
+// Implement SwissTable methods.
+#include <string>
+#include "SwissTable.h"
+using namespace std;
+
+// Places the pair even if key is already in the table, where HashMap::insert would refuse it.
+bool SwissTable::insert(const string& key, int value) {
+	map.insertDuplicate(key, value);
+	return true;
+}
+
+
+// PRE: key/value pair must exist in hash table
+// POST: removes key/value pair if it exists in hash table
+bool SwissTable::remove(const string& key, int value) {
+	return map.removePair(key, value);
+}
+
+
+// PRE: key must exist in hash table
+// POST: copies its value into the value argument
+bool SwissTable::lookup(const string& key, int& value) {
+	return map.lookup(key, value);
+}
+
+
+// PRE: key must exist in hash table
+// POST: modifies the value of the key pair in the hash table to the value that was passed in as an argument
+bool SwissTable::modify(const string& key, int value) {
+	return map.modify(key, value);
+}
+
+
+void SwissTable::getKeys(string*& all_keys, int& nkeys) {
+	map.getKeys(all_keys, nkeys);
+}
+
+
+int SwissTable::numStored() {
+	return map.numStored();
+}
+
+
+int SwissTable::capacity() {
+	return map.capacity();
+}
+
+
+SwissTable::SwissTable() {
+}
+
+
+SwissTable::SwissTable(int nkeys) : map(nkeys) {
+}
+
+
+SwissTable::~SwissTable() {
+}
+
+
+void SwissTable::printTable() {
+	// Print the current state of the hashtable.
+	map.printTable();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include<iostream>
+#include<iomanip>
+#include<string>
+#include "HashMap.h"
+using namespace std;
+
+// A hash table mapping strings to ints with the same interface as HashTable, laid out after the Swiss tables
+// of Abseil: next to the keys and values is an array of 1-byte control bytes, one per slot, that say whether the
+// slot is empty, deleted, or full, and for a full slot hold 7 bits of its key's hash.  Slots are probed in
+// groups of 16 whose control bytes are compared all at once (with SSE2 where available, a plain loop
+// otherwise), so a key is only compared with the strings whose 7 hash bits match, and a lookup usually reads
+// one 16-byte group and one key.
+//
+// Groups are probed quadratically.  The table is rebuilt when full and deleted slots pass 7/8 of it, at twice
+// the size unless removals left mostly deleted slots.
+//
+// The table itself is a HashMap<string,int>.  Like HashTable, and unlike HashMap, a key can be inserted more
+// than once: insert places every pair, remove takes the pair with both the key and the value, and the other
+// functions see the first pair on the key's probe sequence.
+
+class SwissTable {
+ public:
+	// Insert a (key,value) pair into hash table.  Returns true if successful, false if not.
+	bool insert(const string& key, int value);
+
+	bool remove(const string& key, int value);
+
+	// Lookup a key in hash table.  Copies value to value if found and returns true, returns false if key not in table.
+	bool lookup(const string& key, int& value);
+
+	// Modify a (key,value) pair in hash table.  Changes value to value if found and returns true, returns false if key not in table.
+	bool modify(const string& key, int value);
+
+	// Return an array of all the keys in the table.  Stores these nkeys in array keys.
+	void getKeys(string*& all_keys, int& nkeys);
+
+	// Return the number of (key,value) pairs currently in the table.
+	int numStored();
+
+	// Return the number of slots in the table.
+	int capacity();
+
+	// Create a default sized hash table.
+	SwissTable();
+
+	// Create a hash table that can store nkeys keys before it grows (the smallest power of 2 it fills to at most 7/8).
+	SwissTable(int nkeys);
+	~SwissTable();
+
+	// Print the contents of the hash table data structures, useful for debugging.
+	void printTable();
+
+ private:
+	HashMap<string, int> map;
+};
@@ -0,0 +1,132 @@
+//============================================================================
+// Name        : concurrent_bench.cpp
+//============================================================================
+
+// Multi-threaded word counting benchmark for ConcurrentHashMap.
+//
+// The documents (data/*.txt by default) are read and split into words once, then counted as if they were
+// copied until they add up to the given number of megabytes: each thread counts its share of the words, once per
+// copy, with increment() on one shared table.  This runs for 1, 2, 4, ... up to the given number of threads,
+// with a single shard (one lock around a HashMap) and with 256 shards, after a plain HashMap on one thread as
+// the baseline.  Every run checks that the counts add up to the number of words.
+//
+// Usage: concurrent_bench [megabytes] [max threads] [documents...]
+
+#include "ConcurrentHashMap.h"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <stdlib.h>
+
+const int G_WIDTH = 14;
+
+double since(chrono::high_resolution_clock::time_point start) {
+	return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+}
+
+// Appends the lowercased document to text.
+void readDocument(const char* filename, string& text) {
+	ifstream inputfile(filename);
+	if (!inputfile.good()) {
+		cerr << "Could not open " << filename << endl;
+		return;
+	}
+	char c;
+	while (inputfile.get(c)) text += static_cast<char>(tolower(c));
+	text += ' ';
+}
+
+// The words of text, split on anything that is not a letter as word_frequencies does.
+vector<string_view> splitWords(const string& text) {
+	vector<string_view> words;
+	size_t start = 0;
+	for (size_t i=0; i<=text.size(); i++) {
+		if (i < text.size() && text[i] >= 'a' && text[i] <= 'z') continue;
+		if (i > start) words.push_back(string_view(text.data() + start, i - start));
+		start = i + 1;
+	}
+	return words;
+}
+
+// Sum of all the counts in the table.
+template <class Table>
+long long total(Table& table) {
+	string* keys;
+	int nkeys;
+	table.getKeys(keys, nkeys);
+	long long sum = 0;
+	for (int i=0; i<nkeys; i++) {
+		int count;
+		if (table.lookup(keys[i], count)) sum += count;
+	}
+	delete[] keys;
+	return sum;
+}
+
+void report(const char* name, int threads, double seconds, double megabytes, long long nwords, double base) {
+	cout << left << setw(G_WIDTH) << name << setw(G_WIDTH) << threads << setw(G_WIDTH) << seconds
+	     << setw(G_WIDTH) << megabytes / seconds << setw(G_WIDTH) << nwords / seconds / 1e6 << setw(G_WIDTH) << base / seconds << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+	double megabytes = (argc > 1) ? atof(argv[1]) : 1024;
+	int max_threads = (argc > 2) ? atoi(argv[2]) : 64;
+	vector<string> files;
+	for (int i=3; i<argc; i++) files.push_back(argv[i]);
+	if (files.empty()) {
+		files = { "data/0100011.txt", "data/0100021.txt", "data/0100171.txt", "data/1400.txt", "data/pg2554.txt", "data/pg2600.txt" };
+	}
+
+	string text;
+	for (const string& file : files) readDocument(file.c_str(), text);
+	vector<string_view> words = splitWords(text);
+	if (words.empty()) return 1;
+	int copies = max(1, (int)(megabytes * 1048576 / text.size() + 0.5));
+	long long nwords = (long long)words.size() * copies;
+	megabytes = (double)text.size() * copies / 1048576;
+
+	cout << "counting " << words.size() << " words of " << files.size() << " documents " << copies << " times, "
+	     << megabytes << " MB, " << nwords << " words, " << thread::hardware_concurrency() << " hardware threads" << endl;
+	cout << left << setw(G_WIDTH) << "Table" << setw(G_WIDTH) << "threads" << setw(G_WIDTH) << "seconds" << setw(G_WIDTH) << "MB/s"
+	     << setw(G_WIDTH) << "Mwords/s" << setw(G_WIDTH) << "speedup" << endl;
+
+	// One thread, no locks.
+	HashMap<string,int> plain;
+	auto start = chrono::high_resolution_clock::now();
+	for (int c=0; c<copies; c++) {
+		for (string_view word : words) plain.increment(word, 1);
+	}
+	double base = since(start);
+	report("HashMap", 1, base, megabytes, nwords, base);
+	if (total(plain) != nwords) { cout << "wrong counts" << endl; return 1; }
+
+	const int shard_counts[2] = { 1, 256 };
+	for (int shards : shard_counts) {
+		for (int threads=1; threads<=max_threads; threads*=2) {
+			ConcurrentHashMap<string,int> dict(10000, shards);
+			vector<thread> workers;
+			start = chrono::high_resolution_clock::now();
+			for (int t=0; t<threads; t++) {
+				workers.emplace_back([&, t]() {
+					size_t begin = words.size() * t / threads, end = words.size() * (t + 1) / threads;
+					for (int c=0; c<copies; c++) {
+						for (size_t i=begin; i<end; i++) dict.increment(words[i], 1);
+					}
+				});
+			}
+			for (thread& worker : workers) worker.join();
+			double seconds = since(start);
+
+			report(shards == 1 ? "1 shard" : "256 shards", threads, seconds, megabytes, nwords, base);
+			if (total(dict) != nwords) { cout << "wrong counts" << endl; return 1; }
+		}
+	}
+	return 0;
+}
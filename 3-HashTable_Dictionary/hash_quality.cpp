@@ -0,0 +1,152 @@
+//============================================================================
+// Name        : hash_quality.cpp
+//============================================================================
+
+// Reports how well the hash functions of Hash.h spread the words of some documents (data/*.txt by default).
+//
+// For the distinct words of each document, and of all of them together, and for each hash folded to the 32 bits
+// the tables use:
+//   full      pairs of words with equal 32-bit hashes, against the number expected of a random function
+//   mask      words that land in a slot already taken when the hashes are reduced to a table of 2n..4n slots
+//             (a power of 2) by masking the low bits, against the number expected of a random function
+//   range     the same with Lemire's reduction, (hash * slots) >> 32, which keeps the high bits instead
+//   avalanche the mean fraction of the 32 output bits that flip when one input bit flips (0.5 is ideal), and the
+//             worst output bit's distance from flipping half the time, over up to 2000 words
+//
+// Usage: hash_quality [documents...]
+
+#include "Hash.h"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+const int G_WIDTH = 12;
+const int AVALANCHE_WORDS = 2000;
+
+vector<string> readWords(const char* filename);
+
+unsigned int djb2Folded(const string& key) {
+	return static_cast<unsigned int>(djb2(key.data(), key.size()));  // as HashTable::smarterHash
+}
+
+unsigned int wordHashFolded(const string& key) {
+	unsigned long long hash = wordHash(key.data(), key.size());
+	return static_cast<unsigned int>(hash ^ (hash >> 32));  // as HashTable::wordAtATimeHash
+}
+
+// Number of keys landing in a slot already taken, given the slot of each key.
+long long slotCollisions(vector<unsigned int>& slots) {
+	sort(slots.begin(), slots.end());
+	return slots.size() - (unique(slots.begin(), slots.end()) - slots.begin());
+}
+
+void report(const char* name, unsigned int (*hash)(const string&), const vector<string>& words) {
+	long long n = words.size();
+	unsigned int tsize = 8;
+	while (tsize < 2 * n) tsize *= 2;
+
+	vector<unsigned int> full(n), mask(n), range(n);
+	for (long long i=0; i<n; i++) {
+		unsigned int h = hash(words[i]);
+		full[i] = h;
+		mask[i] = h & (tsize - 1);
+		range[i] = static_cast<unsigned int>((static_cast<unsigned long long>(h) * tsize) >> 32);
+	}
+	long long full_coll = slotCollisions(full);
+	long long mask_coll = slotCollisions(mask);
+	long long range_coll = slotCollisions(range);
+
+	// Expected for a random function: n^2 / 2^33 equal pairs, and n - m(1 - (1 - 1/m)^n) keys in taken slots.
+	double full_exp = (double)n * n / 8589934592.0;
+	double slot_exp = n - tsize * (1 - pow(1 - 1.0 / tsize, (double)n));
+
+	long long trials = 0;
+	long long flipped = 0;
+	vector<long long> bit_flips(32, 0);
+	long long step = max(1LL, n / AVALANCHE_WORDS);
+	for (long long i=0; i<n; i+=step) {
+		string key = words[i];
+		unsigned int h = hash(key);
+		for (size_t c=0; c<key.size(); c++) {
+			for (int b=0; b<8; b++) {
+				key[c] ^= static_cast<char>(1 << b);
+				unsigned int diff = h ^ hash(key);
+				key[c] ^= static_cast<char>(1 << b);
+
+				trials++;
+				flipped += __builtin_popcount(diff);
+				for (int o=0; o<32; o++) bit_flips[o] += (diff >> o) & 1;
+			}
+		}
+	}
+	double worst_bias = 0;
+	for (int o=0; o<32; o++) worst_bias = max(worst_bias, fabs((double)bit_flips[o] / trials - 0.5));
+
+	cout << left << setw(G_WIDTH) << name << setw(G_WIDTH) << n << setw(G_WIDTH) << full_coll << setw(G_WIDTH) << full_exp
+	     << setw(G_WIDTH) << tsize << setw(G_WIDTH) << mask_coll << setw(G_WIDTH) << range_coll << setw(G_WIDTH) << slot_exp
+	     << setw(G_WIDTH) << (double)flipped / (32.0 * trials) << setw(G_WIDTH) << worst_bias << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+	vector<string> files;
+	for (int i=1; i<argc; i++) files.push_back(argv[i]);
+	if (files.empty()) {
+		files = { "data/0100011.txt", "data/0100021.txt", "data/0100171.txt", "data/1400.txt", "data/pg2554.txt", "data/pg2600.txt" };
+	}
+
+	set<string> all_words;
+	for (size_t f=0; f<=files.size(); f++) {
+		vector<string> words;
+		if (f < files.size()) {
+			vector<string> w = readWords(files[f].c_str());
+			set<string> distinct(w.begin(), w.end());
+			words.assign(distinct.begin(), distinct.end());
+			all_words.insert(words.begin(), words.end());
+			cout << files[f] << endl;
+		} else {
+			words.assign(all_words.begin(), all_words.end());
+			cout << "all documents" << endl;
+		}
+
+		cout << left << setw(G_WIDTH) << "hash" << setw(G_WIDTH) << "words" << setw(G_WIDTH) << "full" << setw(G_WIDTH) << "expected"
+		     << setw(G_WIDTH) << "slots" << setw(G_WIDTH) << "mask" << setw(G_WIDTH) << "range" << setw(G_WIDTH) << "expected"
+		     << setw(G_WIDTH) << "avalanche" << setw(G_WIDTH) << "worst bias" << endl;
+		report("djb2", djb2Folded, words);
+		report("word", wordHashFolded, words);
+		cout << endl;
+	}
+	return 0;
+}
+
+
+// The lowercase words of a document, split on anything that is not a letter as word_frequencies does.
+vector<string> readWords(const char* filename) {
+	vector<string> words;
+	ifstream inputfile(filename);
+	if (!inputfile.good()) {
+		cerr << "Could not open " << filename << endl;
+		return words;
+	}
+
+	string curr_str;
+	char c;
+	while (inputfile.get(c)) {
+		c = tolower(c);
+		if (c >= 'a' && c <= 'z') {
+			curr_str += c;
+		} else if (!curr_str.empty()) {
+			words.push_back(curr_str);
+			curr_str.clear();
+		}
+	}
+	if (!curr_str.empty()) words.push_back(curr_str);
+	return words;
+}
@@ -0,0 +1,174 @@
+//============================================================================
+// Name        : hashtable_bench.cpp
+//============================================================================
+
+// Lookup benchmark, HashTable against SwissTable.
+//
+// For each load factor, both tables get the same number of slots and are filled with that fraction of
+// distinct words.  HashTable grows past 3/4, so at 7/8 it ends up with twice the slots and the load column shows
+// that.  Then they are timed on lookups of the stored words in random order (hits) and of as many words not in
+// the table (misses).  Finally both count the words of the documents given on the command line (data/*.txt
+// by default) with lookup and then modify or insert, as word_frequencies does.
+//
+// Usage: hashtable_bench [slots] [documents...]
+
+#include "HashTable.h"
+#include "SwissTable.h"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdlib.h>
+
+const int G_WIDTH = 14;
+
+string int2letter(int i);
+string int2word(int i);
+vector<string> readWords(const char* filename);
+
+double since(chrono::high_resolution_clock::time_point start) {
+	return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+}
+
+long long sink;  // sum of the values looked up, so the lookups cannot be optimized away
+
+// Fills a table of the given kind with stored[i] -> i, then times hit and miss lookups and prints a row.
+template <class Table>
+void benchLoad(const char* name, Table& table, const vector<string>& stored, const vector<string>& missing, double load) {
+	for (int i=0; i<(int)stored.size(); i++) {
+		table.insert(stored[i], i);
+	}
+
+	vector<int> order(stored.size());
+	for (int i=0; i<(int)order.size(); i++) order[i] = i;
+	shuffle(order.begin(), order.end(), mt19937(42));
+
+	int val;
+	auto start = chrono::high_resolution_clock::now();
+	for (int i : order) {
+		if (table.lookup(stored[i], val)) sink += val;
+	}
+	double hit = since(start);
+
+	start = chrono::high_resolution_clock::now();
+	for (const string& key : missing) {
+		if (table.lookup(key, val)) sink += val;
+	}
+	double miss = since(start);
+
+	cout << left << setw(G_WIDTH) << name << setw(G_WIDTH) << load << setw(G_WIDTH) << table.capacity()
+	     << setw(G_WIDTH) << (double)table.numStored() / table.capacity()
+	     << setw(G_WIDTH) << hit * 1e9 / stored.size() << setw(G_WIDTH) << miss * 1e9 / missing.size() << endl;
+}
+
+// Counts the words as word_frequencies does and prints a row.
+template <class Table>
+void benchCount(const char* name, Table& table, const vector<string>& words) {
+	auto start = chrono::high_resolution_clock::now();
+	for (const string& word : words) {
+		int count;
+		if (table.lookup(word, count)) {
+			table.modify(word, count+1);
+		} else {
+			table.insert(word, 1);
+		}
+	}
+	double seconds = since(start);
+
+	cout << left << setw(G_WIDTH) << name << setw(G_WIDTH) << seconds << setw(G_WIDTH) << seconds * 1e9 / words.size()
+	     << setw(G_WIDTH) << table.numStored() << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+	int slots = (argc > 1) ? atoi(argv[1]) : 1 << 20;
+	vector<string> files;
+	for (int i=2; i<argc; i++) files.push_back(argv[i]);
+	if (files.empty()) {
+		files = { "data/0100011.txt", "data/0100021.txt", "data/0100171.txt", "data/1400.txt", "data/pg2554.txt", "data/pg2600.txt" };
+	}
+
+	cout << "slots: " << slots << endl;
+	cout << left << setw(G_WIDTH) << "Table" << setw(G_WIDTH) << "load" << setw(G_WIDTH) << "capacity" << setw(G_WIDTH) << "actual load"
+	     << setw(G_WIDTH) << "ns/hit" << setw(G_WIDTH) << "ns/miss" << endl;
+
+	const double loads[3] = { 0.5, 0.75, 0.875 };
+	for (double load : loads) {
+		int n = (int)(load * slots);
+		vector<string> stored(n), missing(n);
+		for (int i=0; i<n; i++) {
+			stored[i] = int2word(2*i);
+			missing[i] = int2word(2*i + 1);
+		}
+
+		// HashTable(nkeys) allocates 4 slots per key, SwissTable(nkeys) as few as fit nkeys at 7/8.
+		HashTable ht(slots / 4);
+		benchLoad("HashTable", ht, stored, missing, load);
+		SwissTable st(slots * 7 / 8);
+		benchLoad("SwissTable", st, stored, missing, load);
+	}
+
+	vector<string> words;
+	for (const string& file : files) {
+		vector<string> w = readWords(file.c_str());
+		words.insert(words.end(), w.begin(), w.end());
+	}
+	cout << endl << "counting " << words.size() << " words of " << files.size() << " documents" << endl;
+	cout << left << setw(G_WIDTH) << "Table" << setw(G_WIDTH) << "seconds" << setw(G_WIDTH) << "ns/word" << setw(G_WIDTH) << "distinct" << endl;
+	HashTable ht;
+	benchCount("HashTable", ht, words);
+	SwissTable st;
+	benchCount("SwissTable", st, words);
+
+	cerr << "checksum " << sink << endl;
+	return 0;
+}
+
+
+// The lowercase words of a document, split on anything that is not a letter as word_frequencies does.
+vector<string> readWords(const char* filename) {
+	vector<string> words;
+	ifstream inputfile(filename);
+	if (!inputfile.good()) {
+		cerr << "Could not open " << filename << endl;
+		return words;
+	}
+
+	string curr_str;
+	char c;
+	while (inputfile.get(c)) {
+		c = tolower(c);
+		if (c >= 'a' && c <= 'z') {
+			curr_str += c;
+		} else if (!curr_str.empty()) {
+			words.push_back(curr_str);
+			curr_str.clear();
+		}
+	}
+	if (!curr_str.empty()) words.push_back(curr_str);
+	return words;
+}
+
+
+// Take an integer and convert it into a letter in A-Z.
+string int2letter(int i) {
+	char the_char = (char) (65 + i % 26);
+	string rtn_string(1,the_char);
+	return rtn_string;
+}
+
+
+// Take an integer and convert it into a distinct word over A-Z, least significant letter first.
+string int2word(int i) {
+	string rtn_string;
+	do {
+		rtn_string += int2letter(i);
+		i /= 26;
+	} while (i > 0);
+	return rtn_string;
+}
@@ -5,13 +5,19 @@
 // A driver program to perform basic tests of hashtable functionality.
 
 #include "HashTable.h"
+#include "SwissTable.h"
+#include "HashMap.h"
+#include "ConcurrentHashMap.h"
 
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdlib.h>
+#include <thread>
+#include <vector>
 
 string int2letter(int i);
+string int2word(int i);
 
 
 
@@ -59,11 +65,20 @@ int main(int argc, char *argv[]) {
 	  2: Insert a (key,value), modify the (key, value), lookup the (key,value).
 	  3: Insert a (key,value), delete (key,value), try to lookup the (key,value).
 	  4: Insert a (key,value), insert (key,value2) to cause collision, delete (key,value), lookup the (key,value2).
-	  5: Many entries.  Insert until table is 75% full.  lookup (last key, value)
+	  5: Many entries.  Insert 76 keys, filling the 128 slot table to about 59%.  lookup (last key, value)
 	  6: Many entries, test reuse.  Insert 200% of table size, with deletions so table is never more than 50% full.  lookup (last key, value).
+	  7: Growth.  Insert 10 times the table size of distinct keys, lookup all of them.
+	  8: Incremental rehash.  Insert, delete every other key and insert again while the table grows a few slots at a time, lookup all keys.
+	  9: Robin Hood probing.  Insert duplicates, delete one, then churn 50 keys through a table of 128 slots, lookup all keys and check the probes stay short.
+	  10: SwissTable.  Insert duplicates, delete one, then insert 1000 keys, delete every other one, lookup all keys.
+	  11: Upserts.  Count 3000 words over 700 keys with increment, findOrInsert and insertOrAssign, in both probing modes, lookup all counts.
+	  12: Hash functions.  Insert 1000 keys during an incremental rehash, switch to djb2 and back, lookup all keys after each switch.
+	  13: HashMap.  Count words through string_view and const char* keys, map ints to strings, remove and lookup.
+	  14: ConcurrentHashMap.  8 threads increment 500 shared keys 20000 times each, one thread also inserts and removes its own keys, lookup all counts.
+	  15: findOrInsert during an incremental rehash.  Hold the reference to a key still in the old arrays across lookups that finish the rehash, add to it, lookup the key; then increment every key of a Robin Hood table while it rehashes.
 	 */
 
-	// This will make a hashtable with 100 spaces.
+	// This will make a hashtable with 128 spaces: room for 4 times 25 keys, rounded up to a power of 2.
 	HashTable ht(25);
 	string key = "a";
 	int val = 0;
@@ -134,7 +149,245 @@ int main(int argc, char *argv[]) {
 		output << val << endl;
 		output << "Number of pairs stored in the table: " << ht.numStored() << endl;
 		break;
-	default:
+	case 7: {
+		for (int i=0; i<1000; i++) {
+			ht.insert(int2word(i),i);
+		}
+
+		bool all_found = true;
+		for (int i=0; i<1000; i++) {
+			if (!ht.lookup(int2word(i),val) || val != i) all_found = false;
+		}
+
+		output << all_found << endl;
+		output << "Number of pairs stored in the table: " << ht.numStored() << endl;
+		output << "Table size: " << ht.capacity() << endl;
+		break;
+	} case 8: {
+		ht.setIncrementalRehash(true);
+		bool saw_rehash = false;
+		for (int i=0; i<2000; i++) {
+			ht.insert(int2word(i),i);
+			saw_rehash = saw_rehash || ht.rehashing();
+		}
+		for (int i=0; i<2000; i+=2) {
+			ht.remove(int2word(i),i);
+		}
+		for (int i=2000; i<4000; i++) {
+			ht.insert(int2word(i),i);
+			saw_rehash = saw_rehash || ht.rehashing();
+		}
+
+		bool all_found = true;
+		for (int i=0; i<4000; i++) {
+			bool found = ht.lookup(int2word(i),val);
+			if (i < 2000 && i % 2 == 0) { if (found) all_found = false; }
+			else if (!found || val != i) all_found = false;
+		}
+
+		output << all_found << endl;
+		output << saw_rehash << endl;
+		output << "Number of pairs stored in the table: " << ht.numStored() << endl;
+		break;
+	} case 9: {
+		HashTable rh(25, HashTable::ROBIN_HOOD);
+		rh.insert(key,20);
+		rh.insert(key,18);
+		rh.remove(key,20);
+		rh.lookup(key,val);
+		output << val << endl;
+		rh.remove(key,18);
+
+		// Keep 50 keys stored, replacing 25 of them each round.
+		for (int i=0; i<50; i++) {
+			rh.insert(int2word(i),i);
+		}
+		for (int j=0; j<200; j++) {
+			for (int i=25*j; i < 25*j + 25; i++) {
+				rh.remove(int2word(i),i);
+			}
+			for (int i=25*(j+2); i < 25*(j+3); i++) {
+				rh.insert(int2word(i),i);
+			}
+		}
+
+		bool all_found = true;
+		for (int i=0; i<25*202; i++) {
+			bool found = rh.lookup(int2word(i),val);
+			if (i < 25*200) { if (found) all_found = false; }
+			else if (!found || val != i) all_found = false;
+		}
+
+		output << all_found << endl;
+		output << (rh.longestProbe() <= 16) << endl;
+		output << "Number of pairs stored in the table: " << rh.numStored() << endl;
+		output << "Table size: " << rh.capacity() << endl;
+		break;
+	} case 10: {
+		SwissTable st(25);
+		st.insert(key,20);
+		st.insert(key,18);
+		st.remove(key,20);
+		st.lookup(key,val);
+		output << val << endl;
+		st.remove(key,18);
+
+		for (int i=0; i<1000; i++) {
+			st.insert(int2word(i),i);
+		}
+		for (int i=0; i<1000; i+=2) {
+			st.remove(int2word(i),i);
+		}
+		for (int i=1; i<1000; i+=2) {
+			st.modify(int2word(i),-i);
+		}
+
+		bool all_found = true;
+		for (int i=0; i<1000; i++) {
+			bool found = st.lookup(int2word(i),val);
+			if (i % 2 == 0) { if (found) all_found = false; }
+			else if (!found || val != -i) all_found = false;
+		}
+
+		output << all_found << endl;
+		output << "Number of pairs stored in the table: " << st.numStored() << endl;
+		output << "Table size: " << st.capacity() << endl;
+		break;
+	} case 11: {
+		HashTable rh(25, HashTable::ROBIN_HOOD);
+		HashTable* tables[2] = { &ht, &rh };
+		for (HashTable* t : tables) {
+			int expect[700] = { 0 };
+			bool ok = true;
+			for (int i=0; i<3000; i++) {
+				int k = (i * 3) % 700;  // keys 0..699 are each met first while i < 700
+				if (i % 3 == 0) {
+					ok = ok && t->increment(int2word(k),2) == expect[k] + 2;
+					expect[k] += 2;
+				} else if (i % 3 == 1) {
+					t->findOrInsert(int2word(k)) += 1;
+					expect[k] += 1;
+				} else {
+					ok = ok && t->insertOrAssign(int2word(k),10) == (i < 700);
+					expect[k] = 10;
+				}
+			}
+			for (int k=0; k<700; k++) {
+				ok = ok && t->lookup(int2word(k),val) && val == expect[k];
+			}
+			output << ok << endl;
+		}
+		output << "Number of pairs stored in the table: " << rh.numStored() << endl;
+		break;
+	} case 12: {
+		ht.setIncrementalRehash(true);
+		for (int i=0; i<1000; i++) {
+			ht.insert(int2word(i),i);
+		}
+
+		bool all_found = true;
+		HashTable::HashFunction hfs[2] = { HashTable::DJB2, HashTable::WORD_AT_A_TIME };
+		for (HashTable::HashFunction hf : hfs) {
+			ht.setHashFunction(hf);
+			for (int i=0; i<1000; i++) {
+				if (!ht.lookup(int2word(i),val) || val != i) all_found = false;
+			}
+		}
+
+		output << all_found << endl;
+		output << "Number of pairs stored in the table: " << ht.numStored() << endl;
+		break;
+	} case 13: {
+		HashMap<string,int> counts(25);
+		const char* text = "the cat and the dog and the bird";
+		for (const char* p = text; *p; ) {
+			const char* end = p;
+			while (*end && *end != ' ') end++;
+			counts.increment(string_view(p, end - p), 1);
+			p = *end ? end + 1 : end;
+		}
+		output << counts.numStored() << endl;
+		counts.lookup("the", val);
+		output << val << endl;
+		output << (counts.find(string_view("and")) != nullptr && *counts.find("and") == 2) << endl;
+		output << counts.insert("cat", 5) << counts.remove("cat") << counts.remove("cat") << endl;
+
+		HashMap<int,string> names;
+		bool all_found = true;
+		for (int i=0; i<1000; i++) {
+			names.insertOrAssign(i, int2word(i));
+		}
+		for (int i=0; i<1000; i+=2) {
+			names.remove(i);
+		}
+		for (int i=0; i<1000; i++) {
+			string name;
+			bool found = names.lookup(i, name);
+			if (i % 2 == 0) { if (found) all_found = false; }
+			else if (!found || name != int2word(i)) all_found = false;
+		}
+		output << all_found << endl;
+		output << "Number of pairs stored in the table: " << names.numStored() << endl;
+		break;
+	} case 14: {
+		ConcurrentHashMap<string,int> counts(25, 16);
+		vector<thread> workers;
+		for (int t=0; t<8; t++) {
+			workers.emplace_back([&counts, t]() {
+				for (int i=0; i<20000; i++) {
+					counts.increment(int2word((i * 7 + t) % 500), 1);
+					if (t == 0 && i % 10 == 0) {
+						counts.insert(int2word(1000 + i), i);
+						counts.remove(int2word(1000 + i));
+					}
+				}
+			});
+		}
+		for (thread& worker : workers) worker.join();
+
+		bool all_found = true;
+		for (int k=0; k<500; k++) {
+			if (!counts.lookup(int2word(k),val) || val != 8 * 20000 / 500) all_found = false;
+		}
+		output << all_found << endl;
+		output << "Number of pairs stored in the table: " << counts.numStored() << endl;
+		break;
+	} case 15: {
+		HashTable lin(256);
+		HashTable rh(256, HashTable::ROBIN_HOOD);
+		HashTable* tables[2] = { &lin, &rh };
+		int nkeys[2] = { 0, 0 };
+		for (int t=0; t<2; t++) {
+			tables[t]->setIncrementalRehash(true);
+			while (!tables[t]->rehashing()) {
+				tables[t]->insert(int2word(nkeys[t]),nkeys[t]);
+				nkeys[t]++;
+			}
+		}
+
+		// Every call moves 16 old slots over, the rehash of 1024 slots finishes while the first references are held.
+		bool ok = true;
+		for (int i=0; i<40; i++) {
+			int& count = lin.findOrInsert(int2word(i));
+			for (int j=1; j<=8; j++) {
+				lin.lookup(int2word(i+j),val);
+			}
+			count += 100;
+			ok = ok && lin.lookup(int2word(i),val) && val == i + 100;
+		}
+		output << ok << endl;
+
+		ok = true;
+		for (int i=0; i<nkeys[1]; i++) {
+			ok = ok && rh.increment(int2word(i),100) == i + 100;
+		}
+		for (int i=0; i<nkeys[1]; i++) {
+			ok = ok && rh.lookup(int2word(i),val) && val == i + 100;
+		}
+		output << ok << endl;
+		output << "Number of pairs stored in the table: " << lin.numStored() << endl;
+		break;
+	} default:
 		cerr << "Invalid test case number" << endl;
 		return 2;
 	}
@@ -158,3 +411,14 @@ string int2letter(int i) {
 	string rtn_string(1,the_char);
 	return rtn_string;
 }
+
+
+// Take an integer and convert it into a distinct word over A-Z, least significant letter first.
+string int2word(int i) {
+	string rtn_string;
+	do {
+		rtn_string += int2letter(i);
+		i /= 26;
+	} while (i > 0);
+	return rtn_string;
+}
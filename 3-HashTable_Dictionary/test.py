@@ -4,7 +4,7 @@ import tempfile
 
 passed = 0
 
-n_tests = 6;
+n_tests = 15;
 
 # Run a for loop of tests.
 for i in range(1,n_tests+1):
@@ -1,12 +1,12 @@
 // A program to calculate word frequencies in a single document.
 #include <iostream>
 #include <fstream>
-#include "HashTable.h"
+#include <string_view>
+#include "HashMap.h"
 
 using namespace std;
 
 #define MAX_STRING_LEN 256
-#define DICT_SIZE 20000
 
 // This program takes command-line arguments.
 // By convention, these parameters are called argc (argument count) and argv (argument vector).
@@ -15,7 +15,7 @@ int main (int argc, char* argv[]) {
 
 	// Local variables.
 	ifstream inputfile;  // ifstream for reading from input file.
-	HashTable dict(DICT_SIZE);  // Dictionary for storing words and their counts.
+	HashMap<string,int> dict;  // Dictionary for storing words and their counts, grows with the vocabulary.
 
 	// Parse command-line arguments.
 	if (argc != 2) {
@@ -61,18 +61,13 @@ int main (int argc, char* argv[]) {
 		}
 
 		if (flush_it) {
-			// Create the new string from curr_str.
-			string the_str(curr_str,str_i);
+			// View curr_str as a string, the dictionary only copies it for a word it has not seen.
+			string_view the_str(curr_str,str_i);
 			// cout << the_str << endl;
 
 
-			// Handle the string, insert/increment count in dictionary.
-			int count;
-			if (dict.lookup(the_str,count)) {
-				dict.modify(the_str,count+1);
-			} else {
-				dict.insert(the_str,1);
-			}
+			// Handle the string, insert/increment count in dictionary with a single probe.
+			dict.increment(the_str,1);
 			
 
 			// Reset state variables.